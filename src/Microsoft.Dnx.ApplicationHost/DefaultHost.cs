@@ -169,7 +169,7 @@ private void Initialize(DefaultHostOptions options, IAssemblyLoadContextAccessor
             var projects = libraries.Where(p => p.Type == Runtime.LibraryTypes.Project)
                                     .ToDictionary(p => p.Identity.Name, p => (ProjectDescription)p);
 
-            var assemblies = PackageDependencyProvider.ResolvePackageAssemblyPaths(libraries);
+            var assemblies = ResolvePackageAssemblyPaths(applicationHostContext, libraries);
 
             // Configure Assembly loaders
             _loaders.Add(new ProjectAssemblyLoader(loadContextAccessor, compilationEngine, projects.Values, options.Configuration));
@@ -192,6 +192,20 @@ private void Initialize(DefaultHostOptions options, IAssemblyLoadContextAccessor
             AddBreadcrumbs(libraries);
         }
 
+        private Dictionary<AssemblyName, string> ResolvePackageAssemblyPaths(ApplicationHostContext applicationHostContext,
+            IEnumerable<LibraryDescription> libraries)
+        {
+            // dnu restore resolves the assembly paths of the target the lock file was restored for
+            var manifest = StartupManifest.Read(applicationHostContext.ProjectDirectory);
+            if (manifest != null && manifest.IsValidFor(_targetFramework, applicationHostContext.RuntimeIdentifiers, applicationHostContext.PackagesDirectory))
+            {
+                Logger.TraceInformation("[{0}]: Using startup manifest with {1} assemblies", GetType().Name, manifest.Assemblies.Count);
+                return manifest.GetAssemblyPaths();
+            }
+
+            return PackageDependencyProvider.ResolvePackageAssemblyPaths(libraries);
+        }
+
 #if FEATURE_DNX_MIN_VERSION_CHECK
         private void ValidateMinRuntimeVersion(IEnumerable<LibraryDescription> libraries)
         {
@@ -0,0 +1,61 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+using System.Collections.Generic;
+using System.IO;
+
+namespace Microsoft.Dnx.Compilation.CSharp
+{
+    /// <summary>
+    /// Memory streams the projects compiled in memory are emitted to. A stream returned to the pool keeps its
+    /// buffer so that the next project is emitted without growing (and copying) a new buffer from scratch. The
+    /// runtime copies the image when it is loaded, after which the stream can be reused.
+    /// </summary>
+    internal static class EmitStreamPool
+    {
+        // An assembly and its symbols for a couple of projects compiled at the same time
+        private const int MaxPooledStreams = 4;
+
+        // The buffers kept alive for the rest of the process - a stream that does not fit is dropped
+        private const long MaxPooledBytes = 64 * 1024 * 1024;
+
+        private static readonly Stack<MemoryStream> _streams = new Stack<MemoryStream>();
+        private static long _pooledBytes;
+
+        public static MemoryStream Rent()
+        {
+            lock (_streams)
+            {
+                if (_streams.Count > 0)
+                {
+                    var stream = _streams.Pop();
+                    _pooledBytes -= stream.Capacity;
+                    return stream;
+                }
+            }
+
+            return new MemoryStream();
+        }
+
+        public static void Return(MemoryStream stream)
+        {
+            // A disposed stream cannot be reused (and throws when its capacity is read)
+            if (!stream.CanWrite)
+            {
+                return;
+            }
+
+            var capacity = stream.Capacity;
+            stream.SetLength(0);
+
+            lock (_streams)
+            {
+                if (_streams.Count < MaxPooledStreams && _pooledBytes + capacity <= MaxPooledBytes)
+                {
+                    _streams.Push(stream);
+                    _pooledBytes += capacity;
+                }
+            }
+        }
+    }
+}
@@ -72,8 +72,12 @@ public IList<ISourceReference> GetSources()
 
         public Assembly Load(AssemblyName assemblyName, IAssemblyLoadContext loadContext)
         {
-            using (var pdbStream = new MemoryStream())
-            using (var assemblyStream = new MemoryStream())
+            // The streams go back to the pool once the runtime has its copy of the image. Compile modules can keep,
+            // replace or dispose the streams of the context so pooled streams are only used if there are none.
+            var reuseStreams = CompilationContext.Modules.Count == 0;
+            var pdbStream = reuseStreams ? EmitStreamPool.Rent() : new MemoryStream();
+            var assemblyStream = reuseStreams ? EmitStreamPool.Rent() : new MemoryStream();
+            try
             {
                 var afterCompileContext = new AfterCompileContext
                 {
@@ -158,6 +162,14 @@ public Assembly Load(AssemblyName assemblyName, IAssemblyLoadContext loadContext
 
                 return assembly;
             }
+            finally
+            {
+                if (reuseStreams)
+                {
+                    EmitStreamPool.Return(assemblyStream);
+                    EmitStreamPool.Return(pdbStream);
+                }
+            }
         }
 
         public void EmitReferenceAssembly(Stream stream)
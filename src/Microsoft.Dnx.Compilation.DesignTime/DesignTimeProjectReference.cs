@@ -56,11 +56,17 @@ public Assembly Load(AssemblyName assemblyName, IAssemblyLoadContext loadContext
 
             if (_response.PdbBytes == null)
             {
-                return loadContext.LoadStream(new MemoryStream(_response.AssemblyBytes), assemblySymbols: null);
+                return loadContext.LoadStream(CreateStream(_response.AssemblyBytes), assemblySymbols: null);
             }
 
-            return loadContext.LoadStream(new MemoryStream(_response.AssemblyBytes),
-                                           new MemoryStream(_response.PdbBytes));
+            return loadContext.LoadStream(CreateStream(_response.AssemblyBytes),
+                                           CreateStream(_response.PdbBytes));
+        }
+
+        private static MemoryStream CreateStream(byte[] bytes)
+        {
+            // A publicly visible buffer is loaded without being copied first (see LoadContext.LoadStream)
+            return new MemoryStream(bytes, 0, bytes.Length, writable: false, publiclyVisible: true);
         }
 
         public void EmitReferenceAssembly(Stream stream)
@@ -7,6 +7,7 @@
 using Microsoft.Extensions.PlatformAbstractions;
 using Microsoft.Dnx.Runtime.Common.DependencyInjection;
 using Microsoft.Dnx.Runtime.Compilation;
+using Microsoft.Dnx.Runtime.Loader;
 using Microsoft.Extensions.CompilationAbstractions;
 
 namespace Microsoft.Dnx.Compilation
@@ -40,7 +41,16 @@ public Assembly LoadProject(Project project, FrameworkName targetFramework, stri
             {
                 if (string.Equals(projectReference.Name, project.Name, StringComparison.OrdinalIgnoreCase))
                 {
-                    return projectReference.Load(assemblyName, loadContext);
+                    var assembly = projectReference.Load(assemblyName, loadContext);
+
+                    // Names requested while the project was compiling (e.g. the project itself, asked for by the
+                    // compiler or by code generators) can be resolved now
+                    if (assembly != null)
+                    {
+                        LoadContext.InvalidateLoadMisses();
+                    }
+
+                    return assembly;
                 }
             }
 
@@ -25,6 +25,7 @@ private unsafe struct NativeBootstrapperContext
         public char* Architecture;
         public char* RuntimeDirectory;
         public char* ApplicationBase;
+        public char* TargetFramework;
     }
 
     [SecurityCritical]
@@ -48,7 +49,7 @@ unsafe static int Execute(int argc, char** argv, NativeBootstrapperContext* cont
             bootstrapperContext.Architecture = new string(context->Architecture);
             bootstrapperContext.RuntimeDirectory = new string(context->RuntimeDirectory);
             bootstrapperContext.ApplicationBase = new string(context->ApplicationBase);
-            bootstrapperContext.TargetFramework = SelectTargetFramework(bootstrapperContext.ApplicationBase);
+            bootstrapperContext.TargetFramework = SelectTargetFramework(context->TargetFramework, bootstrapperContext.ApplicationBase);
             bootstrapperContext.RuntimeType = "CoreClr";
 
             return RuntimeBootstrapper.Execute(arguments, bootstrapperContext);
@@ -57,10 +58,37 @@ unsafe static int Execute(int argc, char** argv, NativeBootstrapperContext* cont
         {
             return ex.HResult != 0 ? ex.HResult : 1;
         }
+        finally
+        {
+            // The native host can exit the process without shutting down the runtime (DNX_FAST_EXIT)
+            Console.Out.Flush();
+            Console.Error.Flush();
+        }
     }
 
     private static readonly FrameworkName DefaultFramework = new FrameworkName(FrameworkNames.LongNames.DnxCore, new Version(5, 0));
 
+    private static unsafe FrameworkName SelectTargetFramework(char* nativeTargetFramework, string applicationBase)
+    {
+        // The native host selects the framework from project.json unless it could not read the file
+        if (nativeTargetFramework != null)
+        {
+            var targetFramework = new string(nativeTargetFramework);
+            if (targetFramework.Length == 0)
+            {
+                return DefaultFramework;
+            }
+
+            FrameworkName fx;
+            if (Microsoft.Dnx.Host.FrameworkNameUtility.TryParseFrameworkName(targetFramework, out fx))
+            {
+                return fx;
+            }
+        }
+
+        return SelectTargetFramework(applicationBase);
+    }
+
     private static FrameworkName SelectTargetFramework(string applicationBase)
     {
         var projectPath = Path.Combine(applicationBase, "project.json");
@@ -196,6 +196,7 @@ private static int BootstrapperOptionValueNum(string candidate)
         }
         else if (string.Equals(candidate, "--watch", StringComparison.OrdinalIgnoreCase) ||
             string.Equals(candidate, "--debug", StringComparison.OrdinalIgnoreCase) ||
+            string.Equals(candidate, "--load-summary", StringComparison.OrdinalIgnoreCase) ||
             string.Equals(candidate, "--help", StringComparison.OrdinalIgnoreCase) ||
             string.Equals(candidate, "-h", StringComparison.OrdinalIgnoreCase) ||
             string.Equals(candidate, "-?", StringComparison.OrdinalIgnoreCase) ||
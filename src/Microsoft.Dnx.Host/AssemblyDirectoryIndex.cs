@@ -0,0 +1,120 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+
+namespace Microsoft.Dnx.Host
+{
+    /// <summary>
+    /// The files and subdirectories of a search path, enumerated once and enumerated again only when the
+    /// last write time of the directory changes (a file or subdirectory was added, removed or renamed).
+    /// A lookup costs a single stat of the directory instead of a stat per candidate file.
+    /// </summary>
+    internal class AssemblyDirectoryIndex
+    {
+        // The coarsest resolution of the last write time of the supported file systems (FAT has 2 seconds, ext3 and
+        // HFS+ have 1 second)
+        private static readonly TimeSpan TimestampResolution = TimeSpan.FromSeconds(2);
+
+        private readonly string _path;
+        private readonly StringComparer _comparer;
+        private volatile Entries _entries;
+
+        public AssemblyDirectoryIndex(string path, StringComparer comparer)
+        {
+            _path = path;
+            _comparer = comparer;
+        }
+
+        /// <summary>
+        /// Returns the path of the first file named <paramref name="name"/> with one of the extensions or null.
+        /// </summary>
+        public string FindFile(string name, string[] extensions)
+        {
+            var entries = GetEntries();
+
+            foreach (var extension in extensions)
+            {
+                string filePath;
+                if (entries.Files.TryGetValue(name + extension, out filePath))
+                {
+                    return filePath;
+                }
+            }
+
+            return null;
+        }
+
+        /// <summary>
+        /// Returns the index of the subdirectory or null if the directory has no such subdirectory.
+        /// </summary>
+        public AssemblyDirectoryIndex GetSubdirectory(string name)
+        {
+            AssemblyDirectoryIndex subdirectory;
+            GetEntries().Subdirectories.TryGetValue(name, out subdirectory);
+            return subdirectory;
+        }
+
+        private Entries GetEntries()
+        {
+            // A missing directory has the same (minimum) last write time until it is created
+            var lastWriteTime = Directory.GetLastWriteTimeUtc(_path);
+
+            var entries = _entries;
+            if (entries != null && entries.IsSettled && entries.LastWriteTime == lastWriteTime)
+            {
+                return entries;
+            }
+
+            // The time is read before the directory is enumerated so that a change made during the enumeration
+            // is picked up by the next lookup. Racing threads build equivalent entries and the last one wins.
+            // A change made within the timestamp resolution of the last one does not change the last write time
+            // so entries enumerated that soon are only used until the directory is enumerated again.
+            var isSettled = DateTime.UtcNow - lastWriteTime >= TimestampResolution;
+            entries = new Entries(lastWriteTime, isSettled, _comparer);
+            try
+            {
+                foreach (var filePath in Directory.EnumerateFiles(_path))
+                {
+                    entries.Files[Path.GetFileName(filePath)] = filePath;
+                }
+
+                foreach (var directoryPath in Directory.EnumerateDirectories(_path))
+                {
+                    entries.Subdirectories[Path.GetFileName(directoryPath)] = new AssemblyDirectoryIndex(directoryPath, _comparer);
+                }
+            }
+            catch (IOException)
+            {
+                // The directory does not exist (any more) - nothing can be loaded from it
+            }
+            catch (UnauthorizedAccessException)
+            {
+            }
+
+            _entries = entries;
+            return entries;
+        }
+
+        private class Entries
+        {
+            public Entries(DateTime lastWriteTime, bool isSettled, StringComparer comparer)
+            {
+                LastWriteTime = lastWriteTime;
+                IsSettled = isSettled;
+                Files = new Dictionary<string, string>(comparer);
+                Subdirectories = new Dictionary<string, AssemblyDirectoryIndex>(comparer);
+            }
+
+            public DateTime LastWriteTime { get; }
+
+            public bool IsSettled { get; }
+
+            public Dictionary<string, string> Files { get; }
+
+            public Dictionary<string, AssemblyDirectoryIndex> Subdirectories { get; }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics.Tracing;
+using System.IO;
+using System.Linq;
+using Microsoft.Dnx.Runtime.Loader;
+
+namespace Microsoft.Dnx.Host
+{
+    /// <summary>
+    /// Collects the assembly loads of the process (dnx --load-summary) and prints them, slowest first, together
+    /// with the totals of each loader.
+    /// </summary>
+    internal class AssemblyLoadSummary : EventListener
+    {
+        private readonly List<AssemblyLoad> _loads = new List<AssemblyLoad>();
+
+        public AssemblyLoadSummary()
+        {
+            EnableEvents(AssemblyLoadEventSource.Log, EventLevel.Informational);
+        }
+
+        protected override void OnEventWritten(EventWrittenEventArgs eventData)
+        {
+            if (eventData.EventId != AssemblyLoadEventSource.AssemblyLoadStopEventId)
+            {
+                return;
+            }
+
+            var load = new AssemblyLoad
+            {
+                AssemblyName = (string)eventData.Payload[0],
+                Loader = (string)eventData.Payload[1],
+                Path = (string)eventData.Payload[2],
+                Source = (string)eventData.Payload[3],
+                DurationMilliseconds = (double)eventData.Payload[4]
+            };
+
+            lock (_loads)
+            {
+                _loads.Add(load);
+            }
+        }
+
+        public void Print(TextWriter writer)
+        {
+            List<AssemblyLoad> loads;
+            lock (_loads)
+            {
+                loads = _loads.OrderByDescending(l => l.DurationMilliseconds).ToList();
+            }
+
+            // The durations include the loads an assembly caused so they do not add up to the total time
+            writer.WriteLine("Assembly loads: {0}, not resolved: {1}", loads.Count, loads.Count(l => l.Loader.Length == 0));
+            writer.WriteLine("{0,10} {1,-24} {2,-12} {3}", "ms", "loader", "source", "assembly (path)");
+            foreach (var load in loads)
+            {
+                writer.WriteLine("{0,10:F2} {1,-24} {2,-12} {3}{4}",
+                    load.DurationMilliseconds,
+                    load.Loader.Length == 0 ? "-" : load.Loader,
+                    load.Source.Length == 0 ? "-" : load.Source,
+                    load.AssemblyName,
+                    load.Path.Length == 0 ? string.Empty : " (" + load.Path + ")");
+            }
+
+            writer.WriteLine();
+            writer.WriteLine("{0,10} {1,-24} {2}", "ms", "loader", "assemblies");
+            foreach (var loader in loads.GroupBy(l => l.Loader.Length == 0 ? "-" : l.Loader)
+                                        .OrderByDescending(g => g.Sum(l => l.DurationMilliseconds)))
+            {
+                writer.WriteLine("{0,10:F2} {1,-24} {2}", loader.Sum(l => l.DurationMilliseconds), loader.Key, loader.Count());
+            }
+        }
+
+        private class AssemblyLoad
+        {
+            public string AssemblyName { get; set; }
+
+            public string Loader { get; set; }
+
+            public string Path { get; set; }
+
+            public string Source { get; set; }
+
+            public double DurationMilliseconds { get; set; }
+        }
+    }
+}
@@ -16,6 +16,11 @@ namespace Microsoft.Dnx.Host
 {
     public class Bootstrapper
     {
+        // The default load context can only be initialized once per process. Hosts that run more than one
+        // application (see dnx_host.h) reuse it together with the assemblies it has already loaded.
+        private static readonly object _defaultContextLock = new object();
+        private static LoaderContainer _container;
+
         private readonly IEnumerable<string> _searchPaths;
 
         public Bootstrapper(IEnumerable<string> searchPaths)
@@ -26,10 +31,9 @@ public Bootstrapper(IEnumerable<string> searchPaths)
         public Task<int> RunAsync(List<string> args, IRuntimeEnvironment env, string appBase, FrameworkName targetFramework)
         {
             var accessor = LoadContextAccessor.Instance;
-            var container = new LoaderContainer();
-            LoadContext.InitializeDefaultContext(new DefaultLoadContext(container));
+            var container = GetDefaultContextContainer();
 
-            var disposable = container.AddLoader(new PathBasedAssemblyLoader(accessor, _searchPaths));
+            var disposable = container.AddLoader(new PathBasedAssemblyLoader(accessor, _searchPaths, env));
 
             try
             {
@@ -85,6 +89,10 @@ public Task<int> RunAsync(List<string> args, IRuntimeEnvironment env, string app
                     // Dispose the host
                     ((IDisposable)state).Dispose();
 
+                    // Tells whether the crossgen'd native images of the deployment are used
+                    Logger.TraceInformation("[{0}]: Assemblies loaded from native images: {1}, IL: {2}, streams: {3}",
+                        nameof(Bootstrapper), LoadContext.NativeImageLoadCount, LoadContext.ILLoadCount, LoadContext.StreamLoadCount);
+
                     return t.GetAwaiter().GetResult();
                 }, disposable);
             }
@@ -95,5 +103,20 @@ public Task<int> RunAsync(List<string> args, IRuntimeEnvironment env, string app
                 throw;
             }
         }
+
+        private static LoaderContainer GetDefaultContextContainer()
+        {
+            lock (_defaultContextLock)
+            {
+                if (_container == null)
+                {
+                    var container = new LoaderContainer();
+                    LoadContext.InitializeDefaultContext(new DefaultLoadContext(container));
+                    _container = container;
+                }
+
+                return _container;
+            }
+        }
     }
 }
@@ -7,6 +7,7 @@
 using System.Linq;
 using System.Reflection;
 using Microsoft.Dnx.Runtime;
+using Microsoft.Dnx.Runtime.Loader;
 using Microsoft.Extensions.PlatformAbstractions;
 
 namespace Microsoft.Dnx.Host
@@ -19,6 +20,9 @@ public IDisposable AddLoader(IAssemblyLoader loader)
         {
             _loaders.Push(loader);
 
+            // Names the previous loaders could not resolve might be resolved by this one
+            LoadContext.InvalidateLoadMisses();
+
             return new DisposableAction(() =>
             {
                 var removed = _loaders.Pop();
@@ -39,6 +43,7 @@ public Assembly Load(AssemblyName assemblyName)
                 var assembly = loader.Load(assemblyName);
                 if (assembly != null)
                 {
+                    AssemblyLoadEventSource.Log.SetLoader(loader.GetType().Name);
                     Logger.TraceInformation("[{0}]: Loaded name={1} in {2}ms", loader.GetType().Name, assemblyName, sw.ElapsedMilliseconds);
                     return assembly;
                 }
@@ -3,7 +3,7 @@
 
 using System;
 using System.Collections.Generic;
-using System.IO;
+using System.Linq;
 using System.Reflection;
 using Microsoft.Dnx.Runtime;
 using Microsoft.Extensions.PlatformAbstractions;
@@ -15,12 +15,19 @@ public class PathBasedAssemblyLoader : IAssemblyLoader
         private static readonly string[] _extensions = new string[] { ".dll", ".exe" };
 
         private readonly IAssemblyLoadContext _loadContext;
-        private readonly IEnumerable<string> _searchPaths;
+        private readonly AssemblyDirectoryIndex[] _searchPaths;
 
-        public PathBasedAssemblyLoader(IAssemblyLoadContextAccessor loadContextAccessor, IEnumerable<string> searchPaths)
+        public PathBasedAssemblyLoader(IAssemblyLoadContextAccessor loadContextAccessor, IEnumerable<string> searchPaths, IRuntimeEnvironment runtimeEnvironment)
         {
             _loadContext = loadContextAccessor.Default;
-            _searchPaths = searchPaths;
+
+            // Match the lookups of the file system: case sensitive on Linux, case insensitive by default on
+            // Windows and OS X
+            var comparer = runtimeEnvironment.OperatingSystem == RuntimeOperatingSystems.Linux ?
+                StringComparer.Ordinal :
+                StringComparer.OrdinalIgnoreCase;
+
+            _searchPaths = searchPaths.Select(path => new AssemblyDirectoryIndex(path, comparer)).ToArray();
         }
 
         public Assembly Load(AssemblyName assemblyName)
@@ -32,20 +39,20 @@ public Assembly Load(AssemblyName assemblyName)
             // C:\HelloWorld\bin\fr-FR\HelloWorld.resources.exe
             foreach (var searchPath in _searchPaths)
             {
-                var path = searchPath;
+                var directory = searchPath;
                 if (!ResourcesHelper.IsResourceNeutralCulture(assemblyName))
                 {
-                    path = Path.Combine(path, assemblyName.CultureName);
+                    directory = directory.GetSubdirectory(assemblyName.CultureName);
+                    if (directory == null)
+                    {
+                        continue;
+                    }
                 }
 
-                foreach (var extension in _extensions)
+                var filePath = directory.FindFile(assemblyName.Name, _extensions);
+                if (filePath != null)
                 {
-                    var filePath = Path.Combine(path, assemblyName.Name + extension);
-
-                    if (File.Exists(filePath))
-                    {
-                        return _loadContext.LoadFile(filePath);
-                    }
+                    return _loadContext.LoadFile(filePath);
                 }
             }
 
@@ -75,11 +75,19 @@ public static Task<int> ExecuteAsync(string[] args, BootstrapperContext bootstra
                 CommandOptionType.MultipleValue);
             var optionDebug = app.Option("--debug", "Waits for the debugger to attach before beginning execution.",
                 CommandOptionType.NoValue);
+            var optionLoadSummary = app.Option("--load-summary", "Prints the assemblies loaded, slowest first, with the loader that served them when the application exits.",
+                CommandOptionType.NoValue);
 
             if (bootstrapperContext.RuntimeType != "Mono")
             {
                 app.Option("--bootstrapper-debug", "Waits for the debugger to attach before bootstrapping runtime.",
                     CommandOptionType.NoValue);
+                app.Option("--perf-map", "Writes /tmp/perf-<pid>.map for the code generated at run time (Linux).",
+                    CommandOptionType.NoValue);
+                app.Option("--cpus <CPUS>", "Runs the process on the given CPUs, e.g. 0-3,8 (Linux).",
+                    CommandOptionType.SingleValue);
+                app.Option("--numa-node <NODE>", "Runs the process on the CPUs and the memory of the given NUMA node (Linux).",
+                    CommandOptionType.SingleValue);
             }
 #if DNX451
             var optionFramework = app.Option("--framework <FRAMEWORK_ID>", "Set the framework version to use when running (i.e. dnx451, dnx452, dnx46, ...)", CommandOptionType.SingleValue);
@@ -157,7 +165,33 @@ public static Task<int> ExecuteAsync(string[] args, BootstrapperContext bootstra
 
             var bootstrapper = new Bootstrapper(searchPaths);
 
-            return bootstrapper.RunAsync(app.RemainingArguments, env, bootstrapperContext.ApplicationBase, bootstrapperContext.TargetFramework);
+            if (!optionLoadSummary.HasValue())
+            {
+                return bootstrapper.RunAsync(app.RemainingArguments, env, bootstrapperContext.ApplicationBase, bootstrapperContext.TargetFramework);
+            }
+
+            var loadSummary = new AssemblyLoadSummary();
+            try
+            {
+                return bootstrapper.RunAsync(app.RemainingArguments, env, bootstrapperContext.ApplicationBase, bootstrapperContext.TargetFramework)
+                    .ContinueWith(t =>
+                    {
+                        PrintLoadSummary(loadSummary);
+                        return t.GetAwaiter().GetResult();
+                    });
+            }
+            catch
+            {
+                PrintLoadSummary(loadSummary);
+                throw;
+            }
+        }
+
+        private static void PrintLoadSummary(AssemblyLoadSummary loadSummary)
+        {
+            // Written to stderr so that it does not mix with the output of the application
+            loadSummary.Print(Console.Error);
+            loadSummary.Dispose();
         }
 
         private static IEnumerable<string> ResolveSearchPaths(string defaultLibPath, List<string> libPaths, List<string> remainingArgs)
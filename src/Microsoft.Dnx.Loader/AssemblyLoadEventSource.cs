@@ -0,0 +1,122 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+using System;
+using System.Diagnostics;
+using System.Diagnostics.Tracing;
+using System.Reflection;
+
+namespace Microsoft.Dnx.Runtime.Loader
+{
+    /// <summary>
+    /// Start and stop events for each assembly the load contexts resolve through their loaders: the assembly
+    /// name, the loader that served it, the path it was loaded from, whether it was loaded from a native image,
+    /// an IL file or a stream and the duration of the load including the loads it caused (e.g. the references of
+    /// a project compiled on the fly). Nothing is recorded unless a listener enabled the source.
+    /// </summary>
+    [EventSource(Name = "Microsoft-Dnx-Loader")]
+    public sealed class AssemblyLoadEventSource : EventSource
+    {
+        public const int AssemblyLoadStartEventId = 1;
+        public const int AssemblyLoadStopEventId = 2;
+
+        public static readonly AssemblyLoadEventSource Log = new AssemblyLoadEventSource();
+
+        // The innermost load of the thread - loads nest when loading an assembly loads others
+        [ThreadStatic]
+        private static LoadOperation _currentLoad;
+
+        private AssemblyLoadEventSource()
+        {
+        }
+
+        [Event(AssemblyLoadStartEventId, Level = EventLevel.Informational)]
+        public void AssemblyLoadStart(string assemblyName)
+        {
+            WriteEvent(AssemblyLoadStartEventId, assemblyName);
+        }
+
+        /// <param name="loader">The type name of the loader that resolved the assembly, empty if none did.</param>
+        /// <param name="source">NativeImage, IL or Stream, empty if the assembly was not loaded.</param>
+        [Event(AssemblyLoadStopEventId, Level = EventLevel.Informational)]
+        public void AssemblyLoadStop(string assemblyName, string loader, string path, string source, double durationMilliseconds)
+        {
+            WriteEvent(AssemblyLoadStopEventId, assemblyName, loader, path, source, durationMilliseconds);
+        }
+
+        /// <summary>
+        /// Records the loader that resolved the assembly currently being loaded on this thread.
+        /// </summary>
+        [NonEvent]
+        public void SetLoader(string loader)
+        {
+            var load = _currentLoad;
+            if (load != null && load.Loader == null)
+            {
+                load.Loader = loader;
+            }
+        }
+
+        [NonEvent]
+        internal LoadOperation StartLoad(AssemblyName assemblyName)
+        {
+            if (!IsEnabled())
+            {
+                return null;
+            }
+
+            var load = new LoadOperation(this, assemblyName.FullName, _currentLoad);
+            _currentLoad = load;
+            AssemblyLoadStart(load.AssemblyName);
+            return load;
+        }
+
+        [NonEvent]
+        internal void SetSource(string path, string source)
+        {
+            // Only the first file of a load is the assembly, the others are loaded by nested loads
+            var load = _currentLoad;
+            if (load != null && load.Path == null)
+            {
+                load.Path = path;
+                load.Source = source;
+            }
+        }
+
+        internal class LoadOperation
+        {
+            private readonly AssemblyLoadEventSource _eventSource;
+            private readonly LoadOperation _parent;
+            private readonly long _startTimestamp;
+
+            public LoadOperation(AssemblyLoadEventSource eventSource, string assemblyName, LoadOperation parent)
+            {
+                _eventSource = eventSource;
+                _parent = parent;
+                _startTimestamp = Stopwatch.GetTimestamp();
+                AssemblyName = assemblyName;
+            }
+
+            public string AssemblyName { get; }
+
+            public string Loader { get; set; }
+
+            public string Path { get; set; }
+
+            public string Source { get; set; }
+
+            public void Stop(Assembly assembly)
+            {
+                var duration = (Stopwatch.GetTimestamp() - _startTimestamp) * 1000.0 / Stopwatch.Frequency;
+                _currentLoad = _parent;
+
+                _eventSource.AssemblyLoadStop(
+                    AssemblyName,
+                    assembly != null ? Loader ?? string.Empty : string.Empty,
+                    assembly != null ? Path ?? string.Empty : string.Empty,
+                    assembly != null ? Source ?? string.Empty : string.Empty,
+                    duration);
+            }
+        }
+    }
+}
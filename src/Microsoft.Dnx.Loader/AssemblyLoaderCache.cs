@@ -2,54 +2,150 @@
 using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Reflection;
+using System.Threading;
 
 namespace Microsoft.Dnx.Runtime.Loader
 {
     internal class AssemblyLoaderCache
     {
-        private readonly ConcurrentDictionary<AssemblyName, object> _assemblyLoadLocks = new ConcurrentDictionary<AssemblyName, object>(AssemblyNameComparer.Ordinal);
+        // The number of names remembered as misses before the negative cache is cleared
+        internal const int MaxMisses = 1024;
+
+        private const int LockCount = 64;
+
+        // Bumped when the loaders could resolve names they failed to resolve before (see Invalidate)
+        private static int _generation;
+
+        private readonly object[] _locks = CreateLocks();
         private readonly ConcurrentDictionary<AssemblyName, Assembly> _assemblyCache = new ConcurrentDictionary<AssemblyName, Assembly>(AssemblyNameComparer.Ordinal);
+        private readonly ConcurrentDictionary<AssemblyName, int> _misses = new ConcurrentDictionary<AssemblyName, int>(AssemblyNameComparer.Ordinal);
+        private readonly ConcurrentDictionary<AssemblyName, int> _loadingThreads = new ConcurrentDictionary<AssemblyName, int>(AssemblyNameComparer.Ordinal);
+        private int _missCount;
+
+        /// <summary>
+        /// Forgets the misses of all the caches.
+        /// </summary>
+        public static void Invalidate()
+        {
+            Interlocked.Increment(ref _generation);
+        }
 
         public Assembly GetOrAdd(AssemblyName name, Func<AssemblyName, Assembly> factory)
         {
-            // If the assembly was already loaded use it
+            // If the assembly was already loaded (or could not be loaded) use it
             Assembly assembly;
-            if (_assemblyCache.TryGetValue(name, out assembly))
+            if (TryGetCached(name, out assembly))
             {
                 return assembly;
             }
 
-            var loadLock = _assemblyLoadLocks.GetOrAdd(name, new object());
+            // Concurrently loading the assembly might result in two distinct instances of the same assembly
+            // being loaded. This was observed when loading via Assembly.LoadStream. Prevent this by letting a single
+            // thread load a name. The lock of the name's stripe is not held while the factory runs since the factory
+            // loads other names (e.g. when a project is compiled) and two names sharing a stripe must not deadlock.
+            var loadLock = _locks[(AssemblyNameComparer.Ordinal.GetHashCode(name) & int.MaxValue) % LockCount];
+            var threadId = Environment.CurrentManagedThreadId;
+            var reentrant = false;
 
-            try
+            lock (loadLock)
             {
-                // Concurrently loading the assembly might result in two distinct instances of the same assembly 
-                // being loaded. This was observed when loading via Assembly.LoadStream. Prevent this by locking on the name.
-                lock (loadLock)
+                while (true)
                 {
-                    if (_assemblyCache.TryGetValue(name, out assembly))
+                    if (TryGetCached(name, out assembly))
                     {
-                        // This would succeed in case the thread was previously waiting on the lock when assembly 
-                        // load was in progress
+                        // This would succeed in case the thread was previously waiting when assembly load was in
+                        // progress
                         return assembly;
                     }
 
-                    assembly = factory(name);
+                    int loadingThreadId;
+                    if (!_loadingThreads.TryGetValue(name, out loadingThreadId))
+                    {
+                        _loadingThreads[name] = threadId;
+                        break;
+                    }
 
-                    if (assembly != null)
+                    if (loadingThreadId == threadId)
                     {
-                        _assemblyCache[name] = assembly;
+                        reentrant = true;
+                        break;
                     }
+
+                    Monitor.Wait(loadLock);
+                }
+            }
+
+            var load = AssemblyLoadEventSource.Log.StartLoad(name);
+            try
+            {
+                var generation = Volatile.Read(ref _generation);
+
+                assembly = factory(name);
+
+                if (assembly != null)
+                {
+                    _assemblyCache[name] = assembly;
+                }
+                else
+                {
+                    AddMiss(name, generation);
                 }
             }
             finally
             {
-                _assemblyLoadLocks.TryRemove(name, out loadLock);
+                load?.Stop(assembly);
+
+                if (!reentrant)
+                {
+                    lock (loadLock)
+                    {
+                        int loadingThreadId;
+                        _loadingThreads.TryRemove(name, out loadingThreadId);
+                        Monitor.PulseAll(loadLock);
+                    }
+                }
             }
 
             return assembly;
         }
 
+        private bool TryGetCached(AssemblyName name, out Assembly assembly)
+        {
+            if (_assemblyCache.TryGetValue(name, out assembly))
+            {
+                return true;
+            }
+
+            int generation;
+            return _misses.TryGetValue(name, out generation) && generation == Volatile.Read(ref _generation);
+        }
+
+        private void AddMiss(AssemblyName name, int generation)
+        {
+            // The misses are usually names no loader knows (AssemblyResolve is raised for every probe of the
+            // runtime) so the cache is bounded by starting over rather than by tracking their use
+            if (Interlocked.Increment(ref _missCount) > MaxMisses)
+            {
+                _misses.Clear();
+                Interlocked.Exchange(ref _missCount, 1);
+            }
+
+            // A miss recorded with the generation read before the factory ran is ignored if the generation moved
+            // while the factory was running
+            _misses[name] = generation;
+        }
+
+        private static object[] CreateLocks()
+        {
+            var locks = new object[LockCount];
+            for (var i = 0; i < locks.Length; i++)
+            {
+                locks[i] = new object();
+            }
+
+            return locks;
+        }
+
         private class AssemblyNameComparer : IEqualityComparer<AssemblyName>
         {
             public static IEqualityComparer<AssemblyName> Ordinal = new AssemblyNameComparer();
@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Concurrent;
+using System.Collections.Generic;
 using System.IO;
 using System.Reflection;
 using System.Threading;
@@ -14,6 +15,15 @@ namespace Microsoft.Dnx.Runtime.Loader
 #if DNXCORE50
     public abstract class LoadContext : AssemblyLoadContext, IAssemblyLoadContext
     {
+        // The names of the native images in each directory an assembly was loaded from. The directories are
+        // enumerated once per process instead of probing for the native image of every assembly.
+        private static readonly ConcurrentDictionary<string, HashSet<string>> _nativeImages =
+            new ConcurrentDictionary<string, HashSet<string>>(PathComparer);
+
+        private static int _nativeImageLoadCount;
+        private static int _ilLoadCount;
+        private static int _streamLoadCount;
+
         private readonly AssemblyLoaderCache _cache = new AssemblyLoaderCache();
         private readonly string _friendlyName;
 
@@ -45,14 +55,21 @@ public Assembly LoadFile(string path)
 
             if (nativeImagePath != null)
             {
+                Interlocked.Increment(ref _nativeImageLoadCount);
+                AssemblyLoadEventSource.Log.SetSource(nativeImagePath, "NativeImage");
                 return LoadFromNativeImagePath(nativeImagePath, path);
             }
 
+            Interlocked.Increment(ref _ilLoadCount);
+            AssemblyLoadEventSource.Log.SetSource(path, "IL");
             return LoadFromAssemblyPath(path);
         }
 
         public Assembly LoadStream(Stream assembly, Stream assemblySymbols)
         {
+            Interlocked.Increment(ref _streamLoadCount);
+            AssemblyLoadEventSource.Log.SetSource(string.Empty, "Stream");
+
             if (assemblySymbols == null)
             {
                 return LoadFromStream(assembly);
@@ -76,31 +93,82 @@ public static void InitializeDefaultContext(LoadContext loadContext)
             AssemblyLoadContext.InitializeDefaultContext(loadContext);
         }
 
+        /// <summary>
+        /// Forgets the assembly names the load contexts failed to load. Call when the loaders can resolve
+        /// names they could not resolve before, e.g. when a loader is added or packages have been restored.
+        /// </summary>
+        public static void InvalidateLoadMisses()
+        {
+            AssemblyLoaderCache.Invalidate();
+        }
+
+        /// <summary>
+        /// The number of assemblies all the load contexts loaded from native images.
+        /// </summary>
+        public static int NativeImageLoadCount
+        {
+            get { return Volatile.Read(ref _nativeImageLoadCount); }
+        }
+
+        /// <summary>
+        /// The number of assemblies all the load contexts loaded from IL files.
+        /// </summary>
+        public static int ILLoadCount
+        {
+            get { return Volatile.Read(ref _ilLoadCount); }
+        }
+
+        /// <summary>
+        /// The number of assemblies all the load contexts loaded from streams (projects compiled in memory).
+        /// </summary>
+        public static int StreamLoadCount
+        {
+            get { return Volatile.Read(ref _streamLoadCount); }
+        }
+
         private string GetNativeImagePath(string ilPath)
         {
             var directory = Path.GetDirectoryName(ilPath);
             var arch = IntPtr.Size == 4 ? "x86" : "AMD64";
 
             var nativeImageName = Path.GetFileNameWithoutExtension(ilPath) + ".ni.dll";
-            var nativePath = Path.Combine(directory, arch, nativeImageName);
+            var archDirectory = Path.Combine(directory, arch);
 
-            if (File.Exists(nativePath))
+            if (GetNativeImages(archDirectory).Contains(nativeImageName))
             {
-                return nativePath;
+                return Path.Combine(archDirectory, nativeImageName);
             }
-            else
+            else if (GetNativeImages(directory).Contains(nativeImageName))
             {
                 // Runtime is arch sensitive so the ni is in the same folder as IL
-                nativePath = Path.Combine(directory, nativeImageName);
-                if (File.Exists(nativePath))
-                {
-                    return nativePath;
-                }
+                return Path.Combine(directory, nativeImageName);
             }
 
             return null;
         }
 
+        private static StringComparer PathComparer
+        {
+            get { return Path.DirectorySeparatorChar == '\\' ? StringComparer.OrdinalIgnoreCase : StringComparer.Ordinal; }
+        }
+
+        private static HashSet<string> GetNativeImages(string directory)
+        {
+            return _nativeImages.GetOrAdd(directory, path =>
+            {
+                var nativeImages = new HashSet<string>(PathComparer);
+                if (Directory.Exists(path))
+                {
+                    foreach (var nativeImagePath in Directory.EnumerateFiles(path, "*.ni.dll"))
+                    {
+                        nativeImages.Add(Path.GetFileName(nativeImagePath));
+                    }
+                }
+
+                return nativeImages;
+            });
+        }
+
         protected override IntPtr LoadUnmanagedDll(string unmanagedDllName)
         {
             if (Path.GetFileNameWithoutExtension(unmanagedDllName) == "kernel32"||
@@ -127,6 +195,10 @@ public abstract class LoadContext : IAssemblyLoadContext
 
         internal static LoadContext Default;
 
+        private static int _nativeImageLoadCount;
+        private static int _ilLoadCount;
+        private static int _streamLoadCount;
+
         private readonly AssemblyLoaderCache _cache = new AssemblyLoaderCache();
 
         private string _contextId;
@@ -158,6 +230,40 @@ public static void InitializeDefaultContext(LoadContext loadContext)
             loadContext._contextId = null;
         }
 
+        /// <summary>
+        /// Forgets the assembly names the load contexts failed to load. Call when the loaders can resolve
+        /// names they could not resolve before, e.g. when a loader is added or packages have been restored.
+        /// </summary>
+        public static void InvalidateLoadMisses()
+        {
+            AssemblyLoaderCache.Invalidate();
+        }
+
+        /// <summary>
+        /// The number of assemblies all the load contexts loaded from native images. Always 0 on the desktop CLR,
+        /// which loads NGen images on its own.
+        /// </summary>
+        public static int NativeImageLoadCount
+        {
+            get { return Volatile.Read(ref _nativeImageLoadCount); }
+        }
+
+        /// <summary>
+        /// The number of assemblies all the load contexts loaded from IL files.
+        /// </summary>
+        public static int ILLoadCount
+        {
+            get { return Volatile.Read(ref _ilLoadCount); }
+        }
+
+        /// <summary>
+        /// The number of assemblies all the load contexts loaded from streams (projects compiled in memory).
+        /// </summary>
+        public static int StreamLoadCount
+        {
+            get { return Volatile.Read(ref _streamLoadCount); }
+        }
+
         public virtual void Dispose()
         {
             if (string.IsNullOrEmpty(_contextId))
@@ -192,11 +298,16 @@ private Assembly LoadAssemblyImpl(AssemblyName assemblyName)
 
         public Assembly LoadFile(string assemblyPath)
         {
+            Interlocked.Increment(ref _ilLoadCount);
+            AssemblyLoadEventSource.Log.SetSource(assemblyPath, "IL");
             return Associate(Assembly.LoadFile(assemblyPath));
         }
 
         public Assembly LoadStream(Stream assemblyStream, Stream assemblySymbols)
         {
+            Interlocked.Increment(ref _streamLoadCount);
+            AssemblyLoadEventSource.Log.SetSource(string.Empty, "Stream");
+
             byte[] assemblyBytes = GetStreamAsByteArray(assemblyStream);
             byte[] assemblySymbolBytes = null;
 
@@ -224,6 +335,13 @@ private byte[] GetStreamAsByteArray(Stream stream)
             var ms = stream as MemoryStream;
             if (ms != null)
             {
+                // Assembly.Load copies the image so a buffer holding exactly the image is passed as is
+                byte[] buffer;
+                if (TryGetExactBuffer(ms, out buffer))
+                {
+                    return buffer;
+                }
+
                 return ms.ToArray();
             }
 
@@ -235,6 +353,23 @@ private byte[] GetStreamAsByteArray(Stream stream)
             }
         }
 
+        private static bool TryGetExactBuffer(MemoryStream stream, out byte[] buffer)
+        {
+            try
+            {
+                buffer = stream.GetBuffer();
+            }
+            catch (UnauthorizedAccessException)
+            {
+                // The buffer of the stream is not publicly visible
+                buffer = null;
+                return false;
+            }
+
+            // A stream over a segment of the buffer is shorter than the buffer
+            return buffer.Length == stream.Length;
+        }
+
         private static Assembly ResolveAssembly(object sender, ResolveEventArgs args)
         {
             var domain = (AppDomain)sender;
@@ -243,7 +378,7 @@ private static Assembly ResolveAssembly(object sender, ResolveEventArgs args)
 
             if (afterPolicy != args.Name)
             {
-                return Assembly.Load(afterPolicy);
+                return LoadAfterPolicy(afterPolicy);
             }
 
             // {context}${name}
@@ -293,6 +428,30 @@ private static Assembly ResolveAssembly(object sender, ResolveEventArgs args)
             return null;
         }
 
+        private static Assembly LoadAfterPolicy(string assemblyName)
+        {
+            Assembly assembly = null;
+            var load = AssemblyLoadEventSource.Log.StartLoad(new AssemblyName(assemblyName));
+            try
+            {
+                assembly = Assembly.Load(assemblyName);
+
+                if (load != null)
+                {
+                    // Resolved by the runtime, from the GAC or the application base
+                    load.Loader = assembly.GlobalAssemblyCache ? "GAC" : "Policy";
+                    load.Path = assembly.Location;
+                    load.Source = "IL";
+                }
+
+                return assembly;
+            }
+            finally
+            {
+                load?.Stop(assembly);
+            }
+        }
+
         private static bool TryLoadAssembly(LoadContext context, AssemblyName assemblyName, out Assembly assembly)
         {
             assembly = context.LoadAssemblyImpl(assemblyName);
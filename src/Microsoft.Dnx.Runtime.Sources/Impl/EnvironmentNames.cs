@@ -10,6 +10,7 @@ internal static class EnvironmentNames
         public const string PackagesCache = "DNX_PACKAGES_CACHE";
         public const string Servicing = "DNX_SERVICING";
         public const string Trace = "DNX_TRACE";
+        public const string TraceBuffer = "DNX_TRACE_BUFFER";
         public const string CompilationServerPort = "DNX_COMPILATION_SERVER_PORT";
         public const string Home = "DNX_HOME";
         public const string GlobalPath = "DNX_GLOBAL_PATH";
@@ -2,41 +2,80 @@
 // Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
 
 using System;
+#if DNXCORE50
+using System.Runtime.InteropServices;
+#endif
 
 namespace Microsoft.Dnx.Runtime
 {
     internal static class Logger
     {
-        public static void TraceError(string message, params object[] args)
+        private const int ErrorLevel = 1;
+        private const int WarningLevel = 2;
+        private const int InformationLevel = 3;
+
+        private static readonly bool _isEnabled = Environment.GetEnvironmentVariable(EnvironmentNames.Trace) == "1";
+
+#if DNXCORE50
+        // The Unix CoreCLR host records the messages in its trace buffer (DNX_TRACE_BUFFER=1) - the message is
+        // copied to the buffer and formatted only when the buffer is dumped
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        private delegate void TraceBufferWriter(int level, string message, int length);
+
+        private static readonly TraceBufferWriter _traceBuffer = GetTraceBufferWriter();
+
+        private static TraceBufferWriter GetTraceBufferWriter()
         {
-            if (IsEnabled)
+            // The host passes the address of the function that writes to the buffer as a runtime property so that
+            // it reaches the copy of this class compiled into each assembly
+            long address;
+            var value = AppContext.GetData(EnvironmentNames.TraceBuffer) as string;
+            if (value == null || !long.TryParse(value, out address) || address == 0)
             {
-                Console.WriteLine("Error: " + message, args);
+                return null;
             }
+
+            return Marshal.GetDelegateForFunctionPointer<TraceBufferWriter>(new IntPtr(address));
+        }
+#endif
+
+        public static void TraceError(string message, params object[] args)
+        {
+            Trace(ErrorLevel, "Error: ", message, args);
         }
 
         public static void TraceInformation(string message, params object[] args)
         {
-            if (IsEnabled)
-            {
-                Console.WriteLine("Information: " + message, args);
-            }
+            Trace(InformationLevel, "Information: ", message, args);
         }
 
         public static void TraceWarning(string message, params object[] args)
         {
-            if (IsEnabled)
-            {
-                Console.WriteLine("Warning: " + message, args);
-            }
+            Trace(WarningLevel, "Warning: ", message, args);
         }
 
         public static bool IsEnabled
         {
             get
             {
-                return Environment.GetEnvironmentVariable(EnvironmentNames.Trace) == "1";
+                return _isEnabled;
+            }
+        }
+
+        private static void Trace(int level, string prefix, string message, object[] args)
+        {
+#if DNXCORE50
+            if (_traceBuffer != null)
+            {
+                var text = args.Length == 0 ? message : string.Format(message, args);
+                _traceBuffer(level, text, text.Length);
+            }
+#endif
+
+            if (_isEnabled)
+            {
+                Console.WriteLine(prefix + message, args);
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -126,6 +126,19 @@ private string ResolvePackagePath(PackageDescription package)
 
         // REVIEW: Should this be here? Is there a better place for this static
         public static void ResolvePackageAssemblyPaths(IEnumerable<LibraryDescription> libraries, Action<PackageDescription, AssemblyName, string> onResolveAssembly)
+        {
+            ResolvePackageAssemblies(libraries, (package, assemblyName, assemblyPath) =>
+            {
+                onResolveAssembly(package, assemblyName, ApplyServicing(
+                    package.Identity.Name,
+                    package.Identity.Version,
+                    assemblyPath,
+                    Path.Combine(package.Path, assemblyPath)));
+            });
+        }
+
+        // The runtime and resource assemblies of the packages, with their paths relative to the package
+        internal static void ResolvePackageAssemblies(IEnumerable<LibraryDescription> libraries, Action<PackageDescription, AssemblyName, string> onResolveAssembly)
         {
             foreach (var library in libraries)
             {
@@ -137,63 +150,40 @@ public static void ResolvePackageAssemblyPaths(IEnumerable<LibraryDescription> l
                     {
                         var assemblyPath = runtimeAssemblyPath.Path;
                         var name = Path.GetFileNameWithoutExtension(assemblyPath);
-                        var path = Path.Combine(library.Path, assemblyPath);
-                        var assemblyName = new AssemblyName(name);
-
-                        string replacementPath;
-                        if (ServicingTable.TryGetReplacement(
-                            library.Identity.Name,
-                            library.Identity.Version,
-                            assemblyPath,
-                            out replacementPath))
-                        {
-                            onResolveAssembly(packageDescription, assemblyName, replacementPath);
-                        }
-                        else
-                        {
-                            onResolveAssembly(packageDescription, assemblyName, path);
-                        }
+                        onResolveAssembly(packageDescription, new AssemblyName(name), assemblyPath);
                     }
 
                     foreach (var runtimeAssemblyPath in packageDescription.Target.ResourceAssemblies)
                     {
                         var assemblyPath = runtimeAssemblyPath.Path;
                         var name = Path.GetFileNameWithoutExtension(assemblyPath);
-                        var path = Path.Combine(library.Path, assemblyPath);
-                        var assemblyName = new AssemblyName(name);
                         string locale;
-                        if (runtimeAssemblyPath.Properties.TryGetValue("locale", out locale))
-                        {
-#if DNXCORE50
-                            assemblyName.CultureName = locale;
-#elif DNX451
-                            assemblyName.CultureInfo = new CultureInfo(locale);
-#else
-#error Unhandled target framework
-#endif
-                        }
-
-                        string replacementPath;
-                        if (ServicingTable.TryGetReplacement(
-                            library.Identity.Name,
-                            library.Identity.Version,
-                            assemblyPath,
-                            out replacementPath))
-                        {
-                            onResolveAssembly(packageDescription, assemblyName, replacementPath);
-                        }
-                        else
-                        {
-                            onResolveAssembly(packageDescription, assemblyName, path);
-                        }
+                        runtimeAssemblyPath.Properties.TryGetValue("locale", out locale);
+                        onResolveAssembly(packageDescription, CreateAssemblyName(name, locale), assemblyPath);
                     }
                 }
             }
         }
 
+        // Returns the path of the patch the servicing index maps the asset of the package to, if any
+        private static string ApplyServicing(string packageId, SemanticVersion packageVersion, string assetPath, string path)
+        {
+            string replacementPath;
+            if (ServicingTable.TryGetReplacement(
+                packageId,
+                packageVersion,
+                assetPath,
+                out replacementPath))
+            {
+                return replacementPath;
+            }
+
+            return path;
+        }
+
         public static Dictionary<AssemblyName, string> ResolvePackageAssemblyPaths(IEnumerable<LibraryDescription> libraries)
         {
-            var assemblies = new Dictionary<AssemblyName, string>(AssemblyNameComparer.OrdinalIgnoreCase);
+            var assemblies = CreateAssemblyMap<string>();
 
             ResolvePackageAssemblyPaths(libraries, (package, assemblyName, path) =>
             {
@@ -203,6 +193,28 @@ public static void ResolvePackageAssemblyPaths(IEnumerable<LibraryDescription> l
             return assemblies;
         }
 
+        internal static Dictionary<AssemblyName, TValue> CreateAssemblyMap<TValue>()
+        {
+            return new Dictionary<AssemblyName, TValue>(AssemblyNameComparer.OrdinalIgnoreCase);
+        }
+
+        internal static AssemblyName CreateAssemblyName(string name, string locale)
+        {
+            var assemblyName = new AssemblyName(name);
+            if (!string.IsNullOrEmpty(locale))
+            {
+#if DNXCORE50
+                assemblyName.CultureName = locale;
+#elif DNX451
+                assemblyName.CultureInfo = new CultureInfo(locale);
+#else
+#error Unhandled target framework
+#endif
+            }
+
+            return assemblyName;
+        }
+
         public static bool IsPlaceholderFile(string path)
         {
             return string.Equals(Path.GetFileName(path), "_._", StringComparison.Ordinal);
@@ -0,0 +1,427 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Runtime.Versioning;
+using System.Text;
+using Microsoft.Dnx.Runtime.Common.Impl;
+using Microsoft.Dnx.Runtime.Servicing;
+using Microsoft.Extensions.PlatformAbstractions;
+using NuGet;
+
+namespace Microsoft.Dnx.Runtime
+{
+    /// <summary>
+    /// The package assemblies and native library directories of the lock file target the CoreCLR host runs
+    /// the project with, resolved by dnu restore so that they do not have to be resolved on every start.
+    /// The native host passes the assemblies to the runtime as trusted platform assemblies and the managed
+    /// host uses them instead of resolving the assembly paths from the lock file libraries.
+    /// </summary>
+    /// <remarks>
+    /// The manifest is stamped with the size and modification time of project.json and project.lock.json
+    /// and is only used while neither file has changed and the packages are resolved from the directory
+    /// they were restored to. The paths are recorded before the servicing index is applied, which is done
+    /// when the manifest is used. The format is read by startup_manifest.cpp in dnx.coreclr.unix and the two
+    /// need to be kept in sync. All values are little endian:
+    ///
+    ///   header:   "DNXSTM03", project.json length and modification time, project.lock.json length and
+    ///             modification time (int64 each, seconds since the Unix epoch)
+    ///   strings:  target framework, operating system, operating system version, architecture, packages
+    ///             directory
+    ///   lists:    runtime identifiers, assemblies (name, culture, package id, package version, path in the
+    ///             package, path), native library directories
+    ///
+    /// A list is a uint32 count followed by the items and a string is a uint32 byte count followed by the
+    /// UTF-8 bytes and a '\0'.
+    /// </remarks>
+    public class StartupManifest
+    {
+        public const string StartupManifestFileName = "project.lock.startup";
+
+        internal delegate bool TryGetReplacement(string packageId, SemanticVersion packageVersion, string assetPath, out string replacementPath);
+
+        private static readonly byte[] Magic = Encoding.ASCII.GetBytes("DNXSTM03");
+        private static readonly DateTime UnixEpoch = new DateTime(1970, 1, 1, 0, 0, 0, DateTimeKind.Utc);
+
+        public FrameworkName TargetFramework { get; set; }
+
+        public string OperatingSystem { get; set; }
+
+        /// <summary>
+        /// The operating system version the runtime identifiers are derived from, e.g. the ID and VERSION_ID of
+        /// /etc/os-release on Linux. The native host compares it since it does not resolve runtime identifiers.
+        /// </summary>
+        public string OperatingSystemVersion { get; set; }
+
+        public string Architecture { get; set; }
+
+        public string PackagesDirectory { get; set; }
+
+        public IList<string> RuntimeIdentifiers { get; set; } = new List<string>();
+
+        public IList<StartupManifestAssembly> Assemblies { get; set; } = new List<StartupManifestAssembly>();
+
+        public IList<string> NativeLibraryDirectories { get; set; } = new List<string>();
+
+        /// <summary>
+        /// Resolves the manifest of the project from the lock file that has just been restored. Returns null
+        /// if the project does not target a framework supported by the CoreCLR host or has no lock file.
+        /// </summary>
+        public static StartupManifest Create(Project project, string packagesDirectory, IRuntimeEnvironment runtimeEnvironment)
+        {
+            // This needs to be in sync with DomainManager.SelectTargetFramework
+            var targetFramework = project.GetTargetFrameworks()
+                .Select(f => f.FrameworkName)
+                .FirstOrDefault(f => f.Identifier == FrameworkNames.LongNames.DnxCore ||
+                                     f.Identifier == FrameworkNames.LongNames.NetStandardApp ||
+                                     f.Identifier == FrameworkNames.LongNames.NetCoreApp);
+
+            if (targetFramework == null ||
+                !File.Exists(Path.Combine(project.ProjectDirectory, LockFileReader.LockFileName)))
+            {
+                return null;
+            }
+
+            var runtimeIdentifiers = runtimeEnvironment.GetAllRuntimeIdentifiers().ToList();
+
+            var context = new ApplicationHostContext
+            {
+                Project = project,
+                PackagesDirectory = packagesDirectory,
+                TargetFramework = targetFramework,
+                RuntimeIdentifiers = runtimeIdentifiers
+            };
+
+            var libraries = ApplicationHostContext.GetRuntimeLibraries(context);
+
+            var manifest = new StartupManifest
+            {
+                TargetFramework = targetFramework,
+                OperatingSystem = runtimeEnvironment.OperatingSystem,
+                OperatingSystemVersion = runtimeEnvironment.OperatingSystemVersion,
+                Architecture = runtimeEnvironment.RuntimeArchitecture,
+                PackagesDirectory = Path.GetFullPath(context.PackagesDirectory),
+                RuntimeIdentifiers = runtimeIdentifiers
+            };
+
+            // The managed host loads project references before packages but the runtime binds trusted platform
+            // assemblies without asking the host, so the assemblies of packages named like a project are left out
+            var projectNames = new HashSet<string>(
+                libraries.OfType<ProjectDescription>().Select(library => library.Identity.Name),
+                StringComparer.OrdinalIgnoreCase);
+
+            // The last package providing a name wins, as in PackageDependencyProvider.ResolvePackageAssemblyPaths
+            var assemblies = PackageDependencyProvider.CreateAssemblyMap<StartupManifestAssembly>();
+            PackageDependencyProvider.ResolvePackageAssemblies(libraries, (package, assemblyName, assemblyPath) =>
+            {
+                if (!IsProvidedByProject(assemblyName, projectNames))
+                {
+                    assemblies[assemblyName] = new StartupManifestAssembly(
+                        assemblyName.Name,
+                        assemblyName.CultureName,
+                        package.Identity.Name,
+                        package.Identity.Version.ToString(),
+                        assemblyPath,
+                        Path.Combine(package.Path, assemblyPath));
+                }
+            });
+
+            foreach (var assembly in assemblies.Values)
+            {
+                manifest.Assemblies.Add(assembly);
+            }
+
+            var nativeLibraryDirectories = new HashSet<string>(StringComparer.Ordinal);
+            foreach (var package in libraries.OfType<PackageDescription>())
+            {
+                foreach (var nativeLibrary in package.Target.NativeLibraries)
+                {
+                    var directory = Path.GetDirectoryName(Path.Combine(package.Path, nativeLibrary.Path));
+                    if (nativeLibraryDirectories.Add(directory))
+                    {
+                        manifest.NativeLibraryDirectories.Add(directory);
+                    }
+                }
+            }
+
+            // The native folders of project references are probed by ProjectAssemblyLoader on every miss. The
+            // folders that exist at restore time are listed so that the runtime finds those libraries first.
+            foreach (var projectDescription in libraries.OfType<ProjectDescription>())
+            {
+                foreach (var folder in NativeLibPathUtils.GetNativeSubfolderCandidates(runtimeEnvironment))
+                {
+                    var directory = NativeLibPathUtils.GetProjectNativeLibPath(Path.GetDirectoryName(projectDescription.Path), folder);
+                    if (Directory.Exists(directory) && nativeLibraryDirectories.Add(directory))
+                    {
+                        manifest.NativeLibraryDirectories.Add(directory);
+                    }
+                }
+            }
+
+            return manifest;
+        }
+
+        /// <summary>
+        /// Reads the manifest from the project directory. Returns null if the manifest does not exist, is
+        /// malformed or is stale.
+        /// </summary>
+        public static StartupManifest Read(string projectDirectory)
+        {
+            var manifestPath = Path.Combine(projectDirectory, StartupManifestFileName);
+            if (!File.Exists(manifestPath))
+            {
+                return null;
+            }
+
+            try
+            {
+                using (var reader = new BinaryReader(new FileStream(manifestPath, FileMode.Open, FileAccess.Read, FileShare.Read)))
+                {
+                    var magic = reader.ReadBytes(Magic.Length);
+                    if (!magic.SequenceEqual(Magic) ||
+                        !ReadStamp(reader).Equals(GetStamp(Path.Combine(projectDirectory, Project.ProjectFileName))) ||
+                        !ReadStamp(reader).Equals(GetStamp(Path.Combine(projectDirectory, LockFileReader.LockFileName))))
+                    {
+                        return null;
+                    }
+
+                    var manifest = new StartupManifest();
+                    manifest.TargetFramework = new FrameworkName(ReadString(reader));
+                    manifest.OperatingSystem = ReadString(reader);
+                    manifest.OperatingSystemVersion = ReadString(reader);
+                    manifest.Architecture = ReadString(reader);
+                    manifest.PackagesDirectory = ReadString(reader);
+
+                    for (var count = reader.ReadUInt32(); count > 0; count--)
+                    {
+                        manifest.RuntimeIdentifiers.Add(ReadString(reader));
+                    }
+
+                    for (var count = reader.ReadUInt32(); count > 0; count--)
+                    {
+                        manifest.Assemblies.Add(new StartupManifestAssembly(
+                            ReadString(reader),
+                            ReadString(reader),
+                            ReadString(reader),
+                            ReadString(reader),
+                            ReadString(reader),
+                            ReadString(reader)));
+                    }
+
+                    for (var count = reader.ReadUInt32(); count > 0; count--)
+                    {
+                        manifest.NativeLibraryDirectories.Add(ReadString(reader));
+                    }
+
+                    return manifest;
+                }
+            }
+            catch (Exception ex)
+            {
+                Logger.TraceWarning($"[{nameof(StartupManifest)}] Failed to read {manifestPath}: {ex.Message}");
+                return null;
+            }
+        }
+
+        /// <summary>
+        /// Writes the manifest to the project directory. The manifest needs to be written after
+        /// project.lock.json since it is stamped with the current state of the lock file.
+        /// </summary>
+        public void Write(string projectDirectory)
+        {
+            var manifestPath = Path.Combine(projectDirectory, StartupManifestFileName);
+            var tempPath = manifestPath + ".tmp";
+
+            using (var writer = new BinaryWriter(new FileStream(tempPath, FileMode.Create, FileAccess.Write, FileShare.None)))
+            {
+                writer.Write(Magic);
+                WriteStamp(writer, GetStamp(Path.Combine(projectDirectory, Project.ProjectFileName)));
+                WriteStamp(writer, GetStamp(Path.Combine(projectDirectory, LockFileReader.LockFileName)));
+
+                WriteString(writer, TargetFramework.ToString());
+                WriteString(writer, OperatingSystem);
+                WriteString(writer, OperatingSystemVersion);
+                WriteString(writer, Architecture);
+                WriteString(writer, PackagesDirectory);
+
+                writer.Write((uint)RuntimeIdentifiers.Count);
+                foreach (var runtimeIdentifier in RuntimeIdentifiers)
+                {
+                    WriteString(writer, runtimeIdentifier);
+                }
+
+                writer.Write((uint)Assemblies.Count);
+                foreach (var assembly in Assemblies)
+                {
+                    WriteString(writer, assembly.Name);
+                    WriteString(writer, assembly.Culture);
+                    WriteString(writer, assembly.PackageId);
+                    WriteString(writer, assembly.PackageVersion);
+                    WriteString(writer, assembly.AssetPath);
+                    WriteString(writer, assembly.Path);
+                }
+
+                writer.Write((uint)NativeLibraryDirectories.Count);
+                foreach (var directory in NativeLibraryDirectories)
+                {
+                    WriteString(writer, directory);
+                }
+            }
+
+            if (File.Exists(manifestPath))
+            {
+                File.Delete(manifestPath);
+            }
+
+            File.Move(tempPath, manifestPath);
+        }
+
+        public static void Delete(string projectDirectory)
+        {
+            var manifestPath = Path.Combine(projectDirectory, StartupManifestFileName);
+            if (File.Exists(manifestPath))
+            {
+                File.Delete(manifestPath);
+            }
+        }
+
+        /// <summary>
+        /// Whether the manifest was resolved for the target the host would select from the lock file and
+        /// from the packages directory the host would resolve the packages from.
+        /// </summary>
+        public bool IsValidFor(FrameworkName targetFramework, IEnumerable<string> runtimeIdentifiers, string packagesDirectory)
+        {
+            return TargetFramework == targetFramework &&
+                RuntimeIdentifiers.SequenceEqual(runtimeIdentifiers, StringComparer.Ordinal) &&
+                !string.IsNullOrEmpty(PackagesDirectory) &&
+                !string.IsNullOrEmpty(packagesDirectory) &&
+                string.Equals(TrimDirectory(PackagesDirectory), TrimDirectory(Path.GetFullPath(packagesDirectory)), PathComparison);
+        }
+
+        /// <summary>
+        /// The paths of the assemblies by name, with the patches of the servicing index applied.
+        /// </summary>
+        public Dictionary<AssemblyName, string> GetAssemblyPaths()
+        {
+            return GetAssemblyPaths(ServicingTable.TryGetReplacement);
+        }
+
+        internal Dictionary<AssemblyName, string> GetAssemblyPaths(TryGetReplacement tryGetReplacement)
+        {
+            var assemblies = PackageDependencyProvider.CreateAssemblyMap<string>();
+
+            foreach (var assembly in Assemblies)
+            {
+                string replacementPath;
+                var assemblyName = PackageDependencyProvider.CreateAssemblyName(assembly.Name, assembly.Culture);
+                if (tryGetReplacement(assembly.PackageId, SemanticVersion.Parse(assembly.PackageVersion), assembly.AssetPath, out replacementPath))
+                {
+                    assemblies[assemblyName] = replacementPath;
+                }
+                else
+                {
+                    assemblies[assemblyName] = assembly.Path;
+                }
+            }
+
+            return assemblies;
+        }
+
+        private static StringComparison PathComparison
+        {
+            get { return Path.DirectorySeparatorChar == '\\' ? StringComparison.OrdinalIgnoreCase : StringComparison.Ordinal; }
+        }
+
+        private static string TrimDirectory(string path)
+        {
+            return path.TrimEnd(Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar);
+        }
+
+        // ProjectAssemblyLoader resolves the project name and the satellite assemblies of the project
+        internal static bool IsProvidedByProject(AssemblyName assemblyName, HashSet<string> projectNames)
+        {
+            var name = assemblyName.Name;
+            if (!string.IsNullOrEmpty(assemblyName.CultureName) &&
+                Path.GetExtension(name).Equals(".resources", StringComparison.OrdinalIgnoreCase))
+            {
+                name = Path.GetFileNameWithoutExtension(name);
+            }
+
+            return projectNames.Contains(name);
+        }
+
+        private static Tuple<long, long> GetStamp(string path)
+        {
+            var fileInfo = new FileInfo(path);
+            if (!fileInfo.Exists)
+            {
+                return Tuple.Create(-1L, -1L);
+            }
+
+            return Tuple.Create(fileInfo.Length, (fileInfo.LastWriteTimeUtc - UnixEpoch).Ticks / TimeSpan.TicksPerSecond);
+        }
+
+        private static Tuple<long, long> ReadStamp(BinaryReader reader)
+        {
+            return Tuple.Create(reader.ReadInt64(), reader.ReadInt64());
+        }
+
+        private static void WriteStamp(BinaryWriter writer, Tuple<long, long> stamp)
+        {
+            writer.Write(stamp.Item1);
+            writer.Write(stamp.Item2);
+        }
+
+        private static string ReadString(BinaryReader reader)
+        {
+            var length = reader.ReadUInt32();
+            var value = Encoding.UTF8.GetString(reader.ReadBytes((int)length));
+            if (reader.ReadByte() != 0)
+            {
+                throw new FormatException("Unterminated string");
+            }
+
+            return value;
+        }
+
+        private static void WriteString(BinaryWriter writer, string value)
+        {
+            var bytes = Encoding.UTF8.GetBytes(value ?? string.Empty);
+            writer.Write((uint)bytes.Length);
+            writer.Write(bytes);
+            writer.Write((byte)0);
+        }
+    }
+
+    public class StartupManifestAssembly
+    {
+        public StartupManifestAssembly(string name, string culture, string packageId, string packageVersion, string assetPath, string path)
+        {
+            Name = name;
+            Culture = culture ?? string.Empty;
+            PackageId = packageId;
+            PackageVersion = packageVersion;
+            AssetPath = assetPath;
+            Path = path;
+        }
+
+        public string Name { get; }
+
+        public string Culture { get; }
+
+        public string PackageId { get; }
+
+        public string PackageVersion { get; }
+
+        /// <summary>
+        /// The path of the assembly relative to the package, as listed in the lock file.
+        /// </summary>
+        public string AssetPath { get; }
+
+        public string Path { get; }
+    }
+}
@@ -14,7 +14,9 @@ public class PackageAssemblyLoader : IAssemblyLoader
     {
         private readonly IDictionary<AssemblyName, string> _assemblies;
         private readonly IAssemblyLoadContextAccessor _loadContextAccessor;
-        private Dictionary<string, string> _nativeLibraryPaths = new Dictionary<string, string>();
+#if DNXCORE50
+        private readonly Lazy<Dictionary<string, string>> _nativeLibraryPaths;
+#endif
 
         public PackageAssemblyLoader(IAssemblyLoadContextAccessor loadContextAccessor,
                                      IDictionary<AssemblyName, string> assemblies,
@@ -22,15 +24,12 @@ public class PackageAssemblyLoader : IAssemblyLoader
         {
             _loadContextAccessor = loadContextAccessor;
             _assemblies = assemblies;
-
-            foreach (var packageDescription in libraryDescriptions.OfType<PackageDescription>())
-            {
-                foreach (var nativeLib in packageDescription.Target.NativeLibraries)
-                {
-                    _nativeLibraryPaths[Path.GetFileNameWithoutExtension(nativeLib.Path)] =
-                        Path.Combine(packageDescription.Path, nativeLib.Path);
-                }
-            }
+#if DNXCORE50
+            // The runtime only asks the loaders for the native libraries it cannot find in the search directories.
+            // With a startup manifest the native directories of the packages are already search directories so
+            // the map is usually never needed.
+            _nativeLibraryPaths = new Lazy<Dictionary<string, string>>(() => GetNativeLibraryPaths(libraryDescriptions));
+#endif
         }
 
         public Assembly Load(AssemblyName assemblyName)
@@ -66,12 +65,29 @@ public IntPtr LoadUnmanagedLibrary(string name)
         {
 #if DNXCORE50
             string path;
-            if (_nativeLibraryPaths.TryGetValue(Path.GetFileNameWithoutExtension(name), out path))
+            if (_nativeLibraryPaths.Value.TryGetValue(Path.GetFileNameWithoutExtension(name), out path))
             {
                 return _loadContextAccessor.Default.LoadUnmanagedLibraryFromPath(path);
             }
 #endif
             return IntPtr.Zero;
         }
+
+#if DNXCORE50
+        private static Dictionary<string, string> GetNativeLibraryPaths(IEnumerable<LibraryDescription> libraryDescriptions)
+        {
+            var nativeLibraryPaths = new Dictionary<string, string>();
+            foreach (var packageDescription in libraryDescriptions.OfType<PackageDescription>())
+            {
+                foreach (var nativeLib in packageDescription.Target.NativeLibraries)
+                {
+                    nativeLibraryPaths[Path.GetFileNameWithoutExtension(nativeLib.Path)] =
+                        Path.Combine(packageDescription.Path, nativeLib.Path);
+                }
+            }
+
+            return nativeLibraryPaths;
+        }
+#endif
     }
 }
@@ -36,7 +36,14 @@ public override Assembly LoadAssembly(AssemblyName assemblyName)
         {
             try
             {
-                return _defaultContext.Load(assemblyName);
+                var assembly = _defaultContext.Load(assemblyName);
+                if (assembly != null)
+                {
+                    // The loader that served the default context is recorded by the nested load
+                    AssemblyLoadEventSource.Log.SetLoader("DefaultLoadContext");
+                }
+
+                return assembly;
             }
             catch (FileNotFoundException)
             {
@@ -46,8 +53,20 @@ public override Assembly LoadAssembly(AssemblyName assemblyName)
 
         public Assembly LoadWithoutDefault(AssemblyName assemblyName)
         {
-            return _projectAssemblyLoader.Load(assemblyName, this) ??
-                   _packageAssemblyLoader.Load(assemblyName, this);
+            var assembly = _projectAssemblyLoader.Load(assemblyName, this);
+            if (assembly != null)
+            {
+                AssemblyLoadEventSource.Log.SetLoader(nameof(ProjectAssemblyLoader));
+                return assembly;
+            }
+
+            assembly = _packageAssemblyLoader.Load(assemblyName, this);
+            if (assembly != null)
+            {
+                AssemblyLoadEventSource.Log.SetLoader(nameof(PackageAssemblyLoader));
+            }
+
+            return assembly;
         }
     }
 }
@@ -12,6 +12,7 @@
 using System.Threading;
 using System.Threading.Tasks;
 using Microsoft.Dnx.Runtime;
+using Microsoft.Dnx.Runtime.Loader;
 using Microsoft.Dnx.Tooling.Publish;
 using Microsoft.Dnx.Tooling.Restore.RuntimeModel;
 using Microsoft.Dnx.Tooling.Utils;
@@ -85,6 +86,9 @@ public async Task<bool> Execute()
 
             summary.DisplaySummary(Reports);
 
+            // The packages just installed provide names the load contexts of this process failed to load before
+            LoadContext.InvalidateLoadMisses();
+
             return success;
         }
 
@@ -526,6 +530,8 @@ private async Task<bool> RestoreForProject(string projectJsonPath, string rootDi
                               targetContexts);
             }
 
+            WriteStartupManifest(project, packagesDirectory);
+
             if (!SkipRestoreEvents)
             {
                 if (!ScriptExecutor.Execute(project, "postrestore", getVariable))
@@ -953,6 +959,27 @@ private Task<LockFile> ReadLockFile(string projectLockFilePath)
             lockFileFormat.Write(projectLockFilePath, lockFile);
         }
 
+        private void WriteStartupManifest(Runtime.Project project, string packagesDirectory)
+        {
+            try
+            {
+                var manifest = StartupManifest.Create(project, packagesDirectory, RuntimeEnvironmentHelper.RuntimeEnvironment);
+                if (manifest == null)
+                {
+                    StartupManifest.Delete(project.ProjectDirectory);
+                    return;
+                }
+
+                manifest.Write(project.ProjectDirectory);
+                Reports.WriteVerbose($"Wrote startup manifest for {manifest.TargetFramework} with {manifest.Assemblies.Count} assemblies");
+            }
+            catch (Exception ex)
+            {
+                // The manifest only speeds up the start of the application - the lock file is used without it
+                Reports.Information.WriteLine($"Failed to write the startup manifest: {ex.Message}".Yellow());
+            }
+        }
+
         private void AddRemoteProvidersFromSources(List<IWalkProvider> remoteProviders, List<PackageSource> effectiveSources, PackageFeedCache packageFeeds, SummaryContext summary)
         {
             foreach (var source in effectiveSources)
@@ -12,6 +12,11 @@ typedef struct CALL_APPLICATION_MAIN_DATA
     int argc; // Number of args in argv
     const dnx::char_t** argv; // Array of arguments
     int exitcode; // Exit code from Managed Application
+    bool perfMap; // Write perf maps of the code generated at run time ('--perf-map')
+    const char* bootstrapperPath; // Full path of the bootstrapper executable on Unix, nullptr if not known
+    const dnx::char_t* cpus; // CPUs to run on e.g. "0-3,8" ('--cpus'), nullptr if not restricted
+    const dnx::char_t* numaNode; // NUMA node to run on and allocate memory from ('--numa-node'), nullptr if not restricted
+    const dnx::char_t* packagesDirectory; // Packages directory passed to the application host ('--packages'), nullptr if not given
 } *PCALL_APPLICATION_MAIN_DATA;
 
 #if defined(_WIN32)
@@ -31,4 +36,7 @@ struct bootstrapper_context
     const wchar_t* architecture;
     const wchar_t* runtime_directory;
     const wchar_t* application_base;
+    // the framework selected from project.json - empty if the default framework is used and null if
+    // the managed host needs to select the framework
+    const wchar_t* target_framework;
 };
\ No newline at end of file
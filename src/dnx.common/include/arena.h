@@ -0,0 +1,90 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace dnx
+{
+    // A bump allocator serving allocations from a single block allocated up front. Allocations are never
+    // freed individually - the block is released when the arena is destroyed. The caller is expected to
+    // size the arena upfront; allocations that do not fit throw std::bad_alloc.
+    class arena
+    {
+    public:
+        explicit arena(size_t capacity)
+            : m_block(new char[capacity]), m_capacity(capacity), m_used(0)
+        {}
+
+        ~arena()
+        {
+            delete[] m_block;
+        }
+
+        void* allocate(size_t size, size_t alignment)
+        {
+            auto offset = (m_used + alignment - 1) & ~(alignment - 1);
+            if (offset > m_capacity || size > m_capacity - offset)
+            {
+                throw std::bad_alloc();
+            }
+
+            m_used = offset + size;
+            return m_block + offset;
+        }
+
+        template <typename T>
+        T* allocate(size_t count)
+        {
+            return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        // copies count characters of value and adds the null terminator
+        template <typename T>
+        T* copy(const T* value, size_t count)
+        {
+            auto buffer = allocate<T>(count + 1);
+            for (size_t i = 0; i < count; i++)
+            {
+                buffer[i] = value[i];
+            }
+
+            buffer[count] = T();
+            return buffer;
+        }
+
+        // Transfers the ownership of the block to the caller. The returned pointer is the address of the
+        // first allocation made from the arena and needs to be freed with arena::free_block.
+        void* release()
+        {
+            auto block = m_block;
+            m_block = nullptr;
+            m_capacity = 0;
+            m_used = 0;
+            return block;
+        }
+
+        static void free_block(void* block)
+        {
+            delete[] static_cast<char*>(block);
+        }
+
+        // The capacity needed to allocate count objects of type T
+        template <typename T>
+        static size_t required_size(size_t count)
+        {
+            // worst case padding needed to align the allocation
+            return sizeof(T) * count + alignof(T) - 1;
+        }
+
+    private:
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        char* m_block;
+        size_t m_capacity;
+        size_t m_used;
+    };
+}
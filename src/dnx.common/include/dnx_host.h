@@ -0,0 +1,45 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+// Hosting API exported by dnx.coreclr.so/dnx.coreclr.dylib for native processes that run DNX applications
+// repeatedly without paying the runtime startup cost for each run. The runtime is initialized once when the
+// host is created and the managed bootstrapper state (e.g. the assemblies that have already been loaded) is
+// reused by all the runs.
+//
+// CoreCLR can be initialized only once per process so only one host can be created during the lifetime of
+// the process. Creating the host can be retried if it failed before the runtime was initialized (e.g. because
+// runtimeconfig.json is malformed). The functions are not thread safe - calls to dnx_host_execute must not
+// overlap. All functions return 0 on success.
+//
+// The process wide settings of dnx are applied when the host is created: DNX_CPUS and DNX_NUMA_NODE place the
+// calling thread and the threads it starts afterwards, and DNX_TRACE_BUFFER=1 records the trace in a buffer that
+// is written to stderr on SIGUSR2 and when the host is destroyed.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dnx_host dnx_host;
+
+// runtime_directory - the directory containing dnx.coreclr.so and the runtime
+// application_base - the full path to the application base
+int dnx_host_create(const char* runtime_directory, const char* application_base, dnx_host** host);
+
+// argv - the arguments as they would be passed to dnx after the expansion done by the bootstrapper
+// (e.g. "--appbase", "/app", "Microsoft.Dnx.ApplicationHost", "run"). The package assemblies of the startup
+// manifest are bound when the host is created so the host must not be used with arguments that change the
+// packages directory ('--packages').
+int dnx_host_execute(dnx_host* host, int argc, const char** argv, int* exit_code);
+
+// Shuts the runtime down. The runtime cannot be used by the process afterwards.
+int dnx_host_destroy(dnx_host* host);
+
+typedef int (*dnx_host_create_fn)(const char* runtime_directory, const char* application_base, dnx_host** host);
+typedef int (*dnx_host_execute_fn)(dnx_host* host, int argc, const char** argv, int* exit_code);
+typedef int (*dnx_host_destroy_fn)(dnx_host* host);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,87 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace dnx
+{
+    namespace json
+    {
+        enum class token_type
+        {
+            begin_object,
+            end_object,
+            begin_array,
+            end_array,
+            string,
+            number,
+            true_value,
+            false_value,
+            null_value,
+            end,
+            error
+        };
+
+        // A pull scanner over a UTF-8 JSON document that does not allocate. Name separators (':') and value
+        // separators (',') are consumed by the scanner and not reported. // and /* */ comments are skipped
+        // since they are allowed in project.json. The scanner checks that the tokens are well formed but not
+        // that they form a valid document - the caller is expected to walk the structure it needs and
+        // skip_value() the rest.
+        class scanner
+        {
+        public:
+            scanner(const char* data, size_t length);
+
+            token_type next();
+
+            // Skips the value that starts with the current token (i.e. the whole object or array if the
+            // current token is begin_object or begin_array). Returns false if the document is malformed.
+            bool skip_value();
+
+            token_type current() const
+            {
+                return m_current;
+            }
+
+            // The text of the current string token without the quotes (escape sequences are not decoded)
+            // or the text of the current number token
+            const char* token_start() const
+            {
+                return m_token_start;
+            }
+
+            size_t token_length() const
+            {
+                return m_token_length;
+            }
+
+            // Compares the current string token with value, decoding escape sequences
+            bool string_equals(const char* value) const;
+
+            // The current string token with escape sequences decoded or the text of any other token
+            std::string token_value() const;
+
+            // The offset of the current token in the document
+            size_t position() const
+            {
+                return static_cast<size_t>(m_token_start - m_data);
+            }
+
+        private:
+            bool skip_whitespace_and_comments();
+            token_type scan_string();
+            token_type scan_number();
+            token_type scan_literal(const char* literal, token_type type);
+
+            const char* m_data;
+            const char* m_position;
+            const char* m_end;
+            const char* m_token_start;
+            size_t m_token_length;
+            token_type m_current;
+        };
+    }
+}
@@ -0,0 +1,41 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+// USDT probes of the "dnx" provider for perf and bpftrace, e.g.
+//
+//   bpftrace -e 'usdt:/path/to/dnx.coreclr.so:dnx:runtime__initialize { printf("%s 0x%x\n", str(arg0), arg1); }'
+//   perf probe -x /path/to/dnx sdt_dnx:phase__start
+//
+// A probe is a single nop in the instruction stream until a tracer attaches to it. The probes are compiled in on
+// Linux when sys/sdt.h (systemtap-sdt-dev) is available and compiled out otherwise or when DNX_DISABLE_PROBES is
+// defined. Probe arguments need to be integers or pointers.
+//
+// Probes:
+//   phase__start(const char* phase), phase__end(const char* phase)    - the phases timed by dnx::phase_timer
+//   host__start(const char* runtime_directory, const char* app_base)  - dnx is about to load the host module
+//   host__exit(int exit_code)                                          - dnx returns from the host module
+//   module__load(const char* path, int loaded)                         - dlopen of the host module
+//   module__return(const char* path, int result)                       - the entry point of the host module returned
+//   coreclr__load(const char* path, int loaded)                        - dlopen of libcoreclr
+//   runtime__initialize(const char* app_base, int hresult)             - coreclr_initialize returned
+//   create__delegate(int hresult)                                      - coreclr_create_delegate returned
+//   app__exit(int exit_code)                                           - the managed entry point returned
+//   runtime__shutdown(int hresult)                                     - coreclr_shutdown returned
+//   fast__exit(int exit_code)                                          - the process exits without shutdown (DNX_FAST_EXIT)
+
+#if defined(__linux__) && !defined(DNX_DISABLE_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define DNX_PROBES_ENABLED 1
+#endif
+#endif
+
+#if defined(DNX_PROBES_ENABLED)
+#define DNX_PROBE1(name, arg1) DTRACE_PROBE1(dnx, name, arg1)
+#define DNX_PROBE2(name, arg1, arg2) DTRACE_PROBE2(dnx, name, arg1, arg2)
+#else
+#define DNX_PROBE1(name, arg1) do { } while (0)
+#define DNX_PROBE2(name, arg1, arg2) do { } while (0)
+#endif
@@ -0,0 +1,16 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace dnx
+{
+    // Picks the framework the CoreCLR host runs the application for from the "frameworks" of a project.json
+    // document - the first key that is a framework supported by CoreCLR. framework is empty if there is no
+    // such key. Returns false if the document cannot be read, in which case the managed host parses it again.
+    // The list of frameworks needs to be in sync with DomainManager.SelectTargetFramework.
+    bool select_target_framework(const char* project_json, size_t length, std::string& framework);
+}
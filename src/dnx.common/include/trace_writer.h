@@ -4,21 +4,43 @@
 #pragma once
 
 #include "xplat.h"
+#include "probes.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
 
 namespace dnx
 {
     class trace_writer
     {
     public:
-        trace_writer(bool verbose) : m_verbose(verbose)
+        // Receives every entry and phase regardless of the verbosity e.g. to record them in a trace buffer
+        typedef void (*entry_sink)(const dnx::char_t* entry, size_t length);
+
+        trace_writer(bool verbose) : m_verbose(verbose), m_sink(nullptr)
+        {}
+
+        // timings_file - if not empty, phase timings are appended to this file as JSON lines
+        trace_writer(bool verbose, const dnx::xstring_t& timings_file)
+            : m_verbose(verbose), m_timings_file(timings_file), m_sink(nullptr)
         {}
 
+        void set_sink(entry_sink sink)
+        {
+            m_sink = sink;
+        }
+
         void write(const dnx::char_t* entry, bool verbose)
         {
             if (!verbose || m_verbose)
             {
                 xout << entry << std::endl;
             }
+
+            if (m_sink)
+            {
+                m_sink(entry, std::char_traits<dnx::char_t>::length(entry));
+            }
         }
 
         void write(const dnx::xstring_t& entry, bool verbose)
@@ -26,7 +48,94 @@ namespace dnx
             write(entry.c_str(), verbose);
         }
 
+        bool timing_enabled() const
+        {
+            return m_verbose || !m_timings_file.empty() || m_sink;
+        }
+
+        // start_us is a timestamp from the monotonic clock (see phase_timer::now_us) so that
+        // phases recorded by different modules of the same process can be ordered
+        void write_phase(const char* phase, long long start_us, long long duration_us)
+        {
+            if (m_verbose || m_sink)
+            {
+                std::ostringstream entry;
+                entry << "Phase '" << phase << "' took " << duration_us << " us (started at " << start_us << " us)";
+                auto entry_str = entry.str();
+                write(dnx::xstring_t(entry_str.begin(), entry_str.end()), true);
+            }
+
+            if (!m_timings_file.empty())
+            {
+                // opened per entry in append mode since the bootstrapper and the host module write to the same file
+                std::ofstream timings(m_timings_file.c_str(), std::ios::out | std::ios::app);
+                if (timings)
+                {
+                    timings << "{\"pid\":" << current_process_id()
+                        << ",\"phase\":\"" << phase
+                        << "\",\"start_us\":" << start_us
+                        << ",\"duration_us\":" << duration_us << "}" << std::endl;
+                }
+            }
+        }
+
     private:
+        static unsigned long current_process_id()
+        {
+#if defined(_WIN32)
+            return GetCurrentProcessId();
+#else
+            return static_cast<unsigned long>(getpid());
+#endif
+        }
+
         bool m_verbose;
+        dnx::xstring_t m_timings_file;
+        entry_sink m_sink;
+    };
+
+    // Measures a bootstrapper phase from construction until stop() is called (or the timer goes out of scope)
+    class phase_timer
+    {
+    public:
+        phase_timer(trace_writer& trace_writer, const char* phase)
+            : m_trace_writer(trace_writer), m_phase(phase), m_start_us(trace_writer.timing_enabled() ? now_us() : 0), m_stopped(false)
+        {
+            DNX_PROBE1(phase__start, phase);
+        }
+
+        ~phase_timer()
+        {
+            stop();
+        }
+
+        void stop()
+        {
+            if (!m_stopped)
+            {
+                m_stopped = true;
+                DNX_PROBE1(phase__end, m_phase);
+
+                if (m_trace_writer.timing_enabled())
+                {
+                    m_trace_writer.write_phase(m_phase, m_start_us, now_us() - m_start_us);
+                }
+            }
+        }
+
+        static long long now_us()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    private:
+        phase_timer(const phase_timer&) = delete;
+        phase_timer& operator=(const phase_timer&) = delete;
+
+        trace_writer& m_trace_writer;
+        const char* m_phase;
+        long long m_start_us;
+        bool m_stopped;
     };
-}
\ No newline at end of file
+}
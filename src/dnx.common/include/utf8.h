@@ -0,0 +1,17 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <cstddef>
+
+namespace dnx
+{
+    namespace utf8
+    {
+        // Converts length bytes of UTF-8 to UTF-16 and returns the number of code units written. Invalid
+        // sequences are replaced with U+FFFD. No terminator is written. A UTF-8 string never needs more
+        // UTF-16 code units than it has bytes so the destination must have room for length code units.
+        size_t to_utf16(const char* source, size_t length, char16_t* destination);
+    }
+}
@@ -25,10 +25,28 @@ namespace dnx
 #if defined(_WIN32)
         std::wstring get_windows_version();
 #endif
+        // The result of a single pass over the bootstrapper options i.e. the arguments preceding
+        // the first non-bootstrapper parameter
+        struct bootstrapper_options
+        {
+            int first_non_bootstrapper_param_index; // -1 if there are only bootstrapper options
+            int appbase_index; // index of '--appbase', -1 if not present
+            int project_index; // index of the first '--project' or '-p', -1 if not present
+            const dnx::char_t* appbase; // value of '--appbase', nullptr if not present or the value is missing
+            bool bootstrapper_debug;
+            bool perf_map; // '--perf-map' is present
+            const dnx::char_t* cpus; // value of '--cpus', nullptr if not present or the value is missing
+            const dnx::char_t* numa_node; // value of '--numa-node', nullptr if not present or the value is missing
+            const dnx::char_t* packages; // value of '--packages', nullptr if not present or the value is missing
+        };
+
+        bootstrapper_options parse_bootstrapper_options(int argc, dnx::char_t** argv);
+
         int find_bootstrapper_option_index(int argc, dnx::char_t**argv, const dnx::char_t* optionName);
         int find_first_non_bootstrapper_param_index(int argc, dnx::char_t**argv);
         dnx::char_t* get_option_value(int argc, dnx::char_t* argv[], const dnx::char_t* optionName);
 
+        void wait_for_debugger();
         void wait_for_debugger(int argc, const dnx::char_t** argv, const dnx::char_t* debug_option);
     }
 }
\ No newline at end of file
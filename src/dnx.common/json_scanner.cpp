@@ -0,0 +1,419 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "json_scanner.h"
+#include <string.h>
+
+namespace dnx
+{
+    namespace json
+    {
+        namespace
+        {
+            bool is_digit(char c)
+            {
+                return c >= '0' && c <= '9';
+            }
+
+            int hex_value(char c)
+            {
+                if (c >= '0' && c <= '9')
+                {
+                    return c - '0';
+                }
+
+                if (c >= 'a' && c <= 'f')
+                {
+                    return c - 'a' + 10;
+                }
+
+                if (c >= 'A' && c <= 'F')
+                {
+                    return c - 'A' + 10;
+                }
+
+                return -1;
+            }
+
+            bool read_hex4(const char* position, unsigned int& value)
+            {
+                value = 0;
+                for (auto i = 0; i < 4; i++)
+                {
+                    auto digit = hex_value(position[i]);
+                    if (digit < 0)
+                    {
+                        return false;
+                    }
+
+                    value = (value << 4) | static_cast<unsigned int>(digit);
+                }
+
+                return true;
+            }
+
+            size_t encode_utf8(unsigned int code_point, char* buffer)
+            {
+                if (code_point < 0x80)
+                {
+                    buffer[0] = static_cast<char>(code_point);
+                    return 1;
+                }
+
+                if (code_point < 0x800)
+                {
+                    buffer[0] = static_cast<char>(0xC0 | (code_point >> 6));
+                    buffer[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+                    return 2;
+                }
+
+                if (code_point < 0x10000)
+                {
+                    buffer[0] = static_cast<char>(0xE0 | (code_point >> 12));
+                    buffer[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                    buffer[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+                    return 3;
+                }
+
+                buffer[0] = static_cast<char>(0xF0 | (code_point >> 18));
+                buffer[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+                buffer[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                buffer[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+                return 4;
+            }
+
+            // Decodes the escape sequence at position (just after the '\') into buffer. Returns the number of
+            // characters of the sequence consumed (0 if the sequence is invalid) and sets decoded_length.
+            size_t decode_escape(const char* position, const char* end, char* buffer, size_t& decoded_length)
+            {
+                decoded_length = 1;
+                switch (*position)
+                {
+                case '"': buffer[0] = '"'; return 1;
+                case '\\': buffer[0] = '\\'; return 1;
+                case '/': buffer[0] = '/'; return 1;
+                case 'b': buffer[0] = '\b'; return 1;
+                case 'f': buffer[0] = '\f'; return 1;
+                case 'n': buffer[0] = '\n'; return 1;
+                case 'r': buffer[0] = '\r'; return 1;
+                case 't': buffer[0] = '\t'; return 1;
+                case 'u':
+                {
+                    unsigned int code_point;
+                    if (end - position < 5 || !read_hex4(position + 1, code_point))
+                    {
+                        return 0;
+                    }
+
+                    // surrogate pair
+                    unsigned int low_surrogate;
+                    if (code_point >= 0xD800 && code_point <= 0xDBFF && end - position >= 11 &&
+                        position[5] == '\\' && position[6] == 'u' && read_hex4(position + 7, low_surrogate) &&
+                        low_surrogate >= 0xDC00 && low_surrogate <= 0xDFFF)
+                    {
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                        decoded_length = encode_utf8(code_point, buffer);
+                        return 11;
+                    }
+
+                    decoded_length = encode_utf8(code_point, buffer);
+                    return 5;
+                }
+                default:
+                    return 0;
+                }
+            }
+        }
+
+        scanner::scanner(const char* data, size_t length)
+            : m_data(data), m_position(data), m_end(data + length), m_token_start(data), m_token_length(0),
+            m_current(token_type::end)
+        {
+            // skip the UTF-8 BOM
+            if (length >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+            {
+                m_position += 3;
+            }
+        }
+
+        bool scanner::skip_whitespace_and_comments()
+        {
+            while (m_position < m_end)
+            {
+                auto c = *m_position;
+                if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ':' || c == ',')
+                {
+                    m_position++;
+                }
+                else if (c == '/' && m_end - m_position >= 2 && m_position[1] == '/')
+                {
+                    while (m_position < m_end && *m_position != '\n')
+                    {
+                        m_position++;
+                    }
+                }
+                else if (c == '/' && m_end - m_position >= 2 && m_position[1] == '*')
+                {
+                    m_position += 2;
+                    while (m_end - m_position >= 2 && !(m_position[0] == '*' && m_position[1] == '/'))
+                    {
+                        m_position++;
+                    }
+
+                    if (m_end - m_position < 2)
+                    {
+                        return false;
+                    }
+
+                    m_position += 2;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            return true;
+        }
+
+        token_type scanner::next()
+        {
+            if (m_current == token_type::error)
+            {
+                return m_current;
+            }
+
+            if (!skip_whitespace_and_comments())
+            {
+                return m_current = token_type::error;
+            }
+
+            m_token_start = m_position;
+            m_token_length = 0;
+
+            if (m_position == m_end)
+            {
+                return m_current = token_type::end;
+            }
+
+            switch (*m_position)
+            {
+            case '{': m_position++; return m_current = token_type::begin_object;
+            case '}': m_position++; return m_current = token_type::end_object;
+            case '[': m_position++; return m_current = token_type::begin_array;
+            case ']': m_position++; return m_current = token_type::end_array;
+            case '"': return m_current = scan_string();
+            case 't': return m_current = scan_literal("true", token_type::true_value);
+            case 'f': return m_current = scan_literal("false", token_type::false_value);
+            case 'n': return m_current = scan_literal("null", token_type::null_value);
+            default: return m_current = scan_number();
+            }
+        }
+
+        token_type scanner::scan_string()
+        {
+            m_token_start = ++m_position;
+            while (m_position < m_end)
+            {
+                auto c = *m_position;
+                if (c == '"')
+                {
+                    m_token_length = static_cast<size_t>(m_position - m_token_start);
+                    m_position++;
+                    return token_type::string;
+                }
+
+                if (c == '\\')
+                {
+                    char buffer[4];
+                    size_t decoded_length;
+                    auto consumed = decode_escape(m_position + 1, m_end, buffer, decoded_length);
+                    if (consumed == 0)
+                    {
+                        return token_type::error;
+                    }
+
+                    m_position += consumed + 1;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    return token_type::error;
+                }
+                else
+                {
+                    m_position++;
+                }
+            }
+
+            return token_type::error;
+        }
+
+        token_type scanner::scan_number()
+        {
+            auto position = m_position;
+            if (position < m_end && *position == '-')
+            {
+                position++;
+            }
+
+            auto digits_start = position;
+            while (position < m_end && is_digit(*position))
+            {
+                position++;
+            }
+
+            if (position == digits_start)
+            {
+                return token_type::error;
+            }
+
+            if (position < m_end && *position == '.')
+            {
+                auto fraction_start = ++position;
+                while (position < m_end && is_digit(*position))
+                {
+                    position++;
+                }
+
+                if (position == fraction_start)
+                {
+                    return token_type::error;
+                }
+            }
+
+            if (position < m_end && (*position == 'e' || *position == 'E'))
+            {
+                position++;
+                if (position < m_end && (*position == '+' || *position == '-'))
+                {
+                    position++;
+                }
+
+                auto exponent_start = position;
+                while (position < m_end && is_digit(*position))
+                {
+                    position++;
+                }
+
+                if (position == exponent_start)
+                {
+                    return token_type::error;
+                }
+            }
+
+            m_token_length = static_cast<size_t>(position - m_position);
+            m_position = position;
+            return token_type::number;
+        }
+
+        token_type scanner::scan_literal(const char* literal, token_type type)
+        {
+            auto length = strlen(literal);
+            if (static_cast<size_t>(m_end - m_position) < length || memcmp(m_position, literal, length) != 0)
+            {
+                return token_type::error;
+            }
+
+            m_token_length = length;
+            m_position += length;
+            return type;
+        }
+
+        bool scanner::skip_value()
+        {
+            auto depth = 0;
+            auto token = m_current;
+            for (;;)
+            {
+                if (token == token_type::begin_object || token == token_type::begin_array)
+                {
+                    depth++;
+                }
+                else if (token == token_type::end_object || token == token_type::end_array)
+                {
+                    depth--;
+                }
+                else if (token == token_type::end || token == token_type::error)
+                {
+                    return false;
+                }
+
+                if (depth <= 0)
+                {
+                    return depth == 0;
+                }
+
+                token = next();
+            }
+        }
+
+        bool scanner::string_equals(const char* value) const
+        {
+            if (m_current != token_type::string)
+            {
+                return false;
+            }
+
+            auto position = m_token_start;
+            auto end = m_token_start + m_token_length;
+            while (position < end)
+            {
+                if (*position == '\\')
+                {
+                    char buffer[4];
+                    size_t decoded_length;
+                    position += decode_escape(position + 1, end, buffer, decoded_length) + 1;
+                    if (strncmp(value, buffer, decoded_length) != 0)
+                    {
+                        return false;
+                    }
+
+                    value += decoded_length;
+                }
+                else
+                {
+                    if (*value != *position)
+                    {
+                        return false;
+                    }
+
+                    value++;
+                    position++;
+                }
+            }
+
+            return *value == '\0';
+        }
+
+        std::string scanner::token_value() const
+        {
+            if (m_current != token_type::string)
+            {
+                return std::string(m_token_start, m_token_length);
+            }
+
+            std::string value;
+            value.reserve(m_token_length);
+
+            auto position = m_token_start;
+            auto end = m_token_start + m_token_length;
+            while (position < end)
+            {
+                if (*position == '\\')
+                {
+                    char buffer[4];
+                    size_t decoded_length;
+                    position += decode_escape(position + 1, end, buffer, decoded_length) + 1;
+                    value.append(buffer, decoded_length);
+                }
+                else
+                {
+                    value.push_back(*position++);
+                }
+            }
+
+            return value;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "target_framework.h"
+#include "json_scanner.h"
+
+namespace dnx
+{
+    namespace
+    {
+        // The short names FrameworkNameUtility.TryParseFrameworkName maps to DNXCore, .NETStandardApp and .NETCoreApp
+        const char* CoreClrFrameworks[] =
+        {
+            "dnxcore50",
+            "netstandardapp1.5",
+            "netcoreapp1.0"
+        };
+
+        bool is_coreclr_framework(const json::scanner& scanner)
+        {
+            for (auto framework : CoreClrFrameworks)
+            {
+                if (scanner.string_equals(framework))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    }
+
+    bool select_target_framework(const char* project_json, size_t length, std::string& framework)
+    {
+        framework.clear();
+
+        json::scanner scanner(project_json, length);
+        if (scanner.next() != json::token_type::begin_object)
+        {
+            return false;
+        }
+
+        while (scanner.next() == json::token_type::string)
+        {
+            auto is_frameworks = scanner.string_equals("frameworks");
+            auto token = scanner.next();
+
+            if (is_frameworks && token == json::token_type::begin_object)
+            {
+                while (scanner.next() == json::token_type::string)
+                {
+                    if (is_coreclr_framework(scanner))
+                    {
+                        framework = scanner.token_value();
+                        return true;
+                    }
+
+                    scanner.next();
+                    if (!scanner.skip_value())
+                    {
+                        return false;
+                    }
+                }
+
+                return scanner.current() == json::token_type::end_object;
+            }
+
+            if (!scanner.skip_value())
+            {
+                return false;
+            }
+        }
+
+        return scanner.current() == json::token_type::end_object;
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "utf8.h"
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTF8_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace dnx
+{
+    namespace utf8
+    {
+        namespace
+        {
+            const char16_t replacement_character = 0xFFFD;
+
+            bool is_continuation(uint8_t c)
+            {
+                return (c & 0xC0) == 0x80;
+            }
+
+            // Decodes a single (possibly invalid) sequence starting at source[0] and returns the number of bytes consumed
+            size_t decode_sequence(const uint8_t* source, size_t remaining, char16_t*& destination)
+            {
+                auto lead = source[0];
+
+                if (lead < 0x80)
+                {
+                    *destination++ = lead;
+                    return 1;
+                }
+
+                if (lead >= 0xC2 && lead <= 0xDF)
+                {
+                    if (remaining >= 2 && is_continuation(source[1]))
+                    {
+                        *destination++ = static_cast<char16_t>(((lead & 0x1F) << 6) | (source[1] & 0x3F));
+                        return 2;
+                    }
+                }
+                else if (lead >= 0xE0 && lead <= 0xEF)
+                {
+                    // exclude overlong encodings (E0 80..9F) and surrogates (ED A0..BF)
+                    if (remaining >= 3 && is_continuation(source[1]) && is_continuation(source[2]) &&
+                        (lead != 0xE0 || source[1] >= 0xA0) && (lead != 0xED || source[1] < 0xA0))
+                    {
+                        *destination++ = static_cast<char16_t>(((lead & 0x0F) << 12) | ((source[1] & 0x3F) << 6) | (source[2] & 0x3F));
+                        return 3;
+                    }
+                }
+                else if (lead >= 0xF0 && lead <= 0xF4)
+                {
+                    // exclude overlong encodings (F0 80..8F) and code points above U+10FFFF (F4 90..BF)
+                    if (remaining >= 4 && is_continuation(source[1]) && is_continuation(source[2]) && is_continuation(source[3]) &&
+                        (lead != 0xF0 || source[1] >= 0x90) && (lead != 0xF4 || source[1] < 0x90))
+                    {
+                        auto code_point = ((lead & 0x07u) << 18) | ((source[1] & 0x3Fu) << 12) | ((source[2] & 0x3Fu) << 6) | (source[3] & 0x3Fu);
+                        code_point -= 0x10000;
+                        *destination++ = static_cast<char16_t>(0xD800 + (code_point >> 10));
+                        *destination++ = static_cast<char16_t>(0xDC00 + (code_point & 0x3FF));
+                        return 4;
+                    }
+                }
+
+                *destination++ = replacement_character;
+                return 1;
+            }
+        }
+
+        size_t to_utf16(const char* source, size_t length, char16_t* destination)
+        {
+            auto input = reinterpret_cast<const uint8_t*>(source);
+            auto end = input + length;
+            auto output = destination;
+
+            while (input < end)
+            {
+#if defined(UTF8_USE_SSE2)
+                if (end - input >= 16)
+                {
+                    auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+                    if (_mm_movemask_epi8(chunk) == 0)
+                    {
+                        // Fast path - widen 16 ASCII characters at once
+                        auto zero = _mm_setzero_si128();
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi8(chunk, zero));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 8), _mm_unpackhi_epi8(chunk, zero));
+                        input += 16;
+                        output += 16;
+                        continue;
+                    }
+
+                    // The block contains non-ASCII characters - decode it one sequence at a time
+                    auto block_end = input + 16;
+                    while (input < block_end)
+                    {
+                        input += decode_sequence(input, static_cast<size_t>(end - input), output);
+                    }
+
+                    continue;
+                }
+#endif
+                input += decode_sequence(input, static_cast<size_t>(end - input), output);
+            }
+
+            return static_cast<size_t>(output - destination);
+        }
+    }
+}
@@ -4,7 +4,9 @@
 #include "stdafx.h"
 
 #include "xplat.h"
+#include "utils.h"
 #include <string>
+#include <stdint.h>
 
 // <codecvt> not supported in libstdc++ (gcc, Clang) but conversions from wstring are only
 // meant to be used on Windows
@@ -13,6 +15,7 @@
 #include <codecvt>
 #else
 #include<string.h>
+#include <sys/stat.h>
 #endif
 
 namespace dnx
@@ -111,6 +114,20 @@ namespace dnx
 
             return attributes != INVALID_FILE_ATTRIBUTES && ((attributes & FILE_ATTRIBUTE_DIRECTORY) != 0);
         }
+#else
+        bool file_exists(const xstring_t& path)
+        {
+            struct stat file_stat;
+
+            return stat(path.c_str(), &file_stat) == 0 && !S_ISDIR(file_stat.st_mode);
+        }
+
+        bool directory_exists(const xstring_t& path)
+        {
+            struct stat file_stat;
+
+            return stat(path.c_str(), &file_stat) == 0 && S_ISDIR(file_stat.st_mode);
+        }
 #endif
 
         xstring_t remove_file_from_path(const xstring_t& path)
@@ -143,33 +160,196 @@ namespace dnx
         }
 
 #endif
-        int get_bootstrapper_option_arg_count(const dnx::char_t* option_name)
+        namespace
         {
-            if (strings_equal_ignore_case(option_name, _X("--appbase")) ||
-                strings_equal_ignore_case(option_name, _X("--lib")) ||
-                strings_equal_ignore_case(option_name, _X("--packages")) ||
-                strings_equal_ignore_case(option_name, _X("--configuration")) ||
-                strings_equal_ignore_case(option_name, _X("--framework")) ||
-                strings_equal_ignore_case(option_name, _X("--port")) ||
-                strings_equal_ignore_case(option_name, _X("--project")) ||
-                strings_equal_ignore_case(option_name, _X("-p")))
+            enum class bootstrapper_option_id
+            {
+                appbase,
+                project,
+                bootstrapper_debug,
+                perf_map,
+                cpus,
+                numa_node,
+                packages,
+                other
+            };
+
+            struct bootstrapper_option
+            {
+                const dnx::char_t* name;
+                int arg_count;
+                bootstrapper_option_id id;
+            };
+
+            constexpr bootstrapper_option bootstrapper_option_table[] =
+            {
+                { _X("--appbase"), 1, bootstrapper_option_id::appbase },
+                { _X("--lib"), 1, bootstrapper_option_id::other },
+                { _X("--packages"), 1, bootstrapper_option_id::packages },
+                { _X("--configuration"), 1, bootstrapper_option_id::other },
+                { _X("--framework"), 1, bootstrapper_option_id::other },
+                { _X("--port"), 1, bootstrapper_option_id::other },
+                { _X("--project"), 1, bootstrapper_option_id::project },
+                { _X("-p"), 1, bootstrapper_option_id::project },
+                { _X("--watch"), 0, bootstrapper_option_id::other },
+                { _X("--debug"), 0, bootstrapper_option_id::other },
+                { _X("--load-summary"), 0, bootstrapper_option_id::other },
+                { _X("--bootstrapper-debug"), 0, bootstrapper_option_id::bootstrapper_debug },
+                { _X("--perf-map"), 0, bootstrapper_option_id::perf_map },
+                { _X("--cpus"), 1, bootstrapper_option_id::cpus },
+                { _X("--numa-node"), 1, bootstrapper_option_id::numa_node },
+                { _X("--help"), 0, bootstrapper_option_id::other },
+                { _X("-h"), 0, bootstrapper_option_id::other },
+                { _X("-?"), 0, bootstrapper_option_id::other },
+                { _X("--version"), 0, bootstrapper_option_id::other },
+            };
+
+            const size_t bootstrapper_option_count = sizeof(bootstrapper_option_table) / sizeof(bootstrapper_option_table[0]);
+
+            // The option names are hashed into a table with no collisions so that recognizing an argument
+            // takes a single hash and at most one string comparison. If adding an option trips the
+            // static_assert below increase the number of slots.
+            const size_t option_slot_count = 53;
+
+            // Arguments longer than this cannot be options so there is no need to hash them completely
+            const size_t max_hashed_length = 32;
+
+            constexpr uint32_t to_lower_ascii(dnx::char_t c)
             {
-                return 1;
+                return static_cast<uint32_t>(c >= _X('A') && c <= _X('Z') ? c - _X('A') + _X('a') : c);
             }
 
-            if (strings_equal_ignore_case(option_name, _X("--watch")) ||
-                strings_equal_ignore_case(option_name, _X("--debug")) ||
-                strings_equal_ignore_case(option_name, _X("--bootstrapper-debug")) ||
-                strings_equal_ignore_case(option_name, _X("--help")) ||
-                strings_equal_ignore_case(option_name, _X("-h")) ||
-                strings_equal_ignore_case(option_name, _X("-?")) ||
-                strings_equal_ignore_case(option_name, _X("--version")))
+            // FNV-1a of the ASCII-lowercased name
+            constexpr uint32_t option_hash(const dnx::char_t* name, size_t remaining, uint32_t hash)
             {
-                return 0;
+                return *name == 0 || remaining == 0
+                    ? hash
+                    : option_hash(name + 1, remaining - 1, (hash ^ to_lower_ascii(*name)) * 16777619u);
             }
 
-            // It isn't a bootstrapper option
-            return -1;
+            constexpr size_t option_slot(const dnx::char_t* name)
+            {
+                return option_hash(name, max_hashed_length, 2166136261u) % option_slot_count;
+            }
+
+            constexpr int find_option_for_slot(size_t slot, size_t option_index)
+            {
+                return option_index == bootstrapper_option_count
+                    ? -1
+                    : option_slot(bootstrapper_option_table[option_index].name) == slot
+                        ? static_cast<int>(option_index)
+                        : find_option_for_slot(slot, option_index + 1);
+            }
+
+            constexpr bool options_have_distinct_slots(size_t option_index)
+            {
+                return option_index == bootstrapper_option_count ||
+                    (find_option_for_slot(option_slot(bootstrapper_option_table[option_index].name), 0) == static_cast<int>(option_index) &&
+                    options_have_distinct_slots(option_index + 1));
+            }
+
+            static_assert(options_have_distinct_slots(0), "Bootstrapper option names collide - increase option_slot_count");
+
+            template <size_t... I> struct index_list {};
+            template <size_t N, size_t... I> struct make_index_list : make_index_list<N - 1, N - 1, I...> {};
+            template <size_t... I> struct make_index_list<0, I...> { typedef index_list<I...> type; };
+
+            struct option_slot_table
+            {
+                // index into bootstrapper_option_table or -1 for empty slots
+                signed char option_index[option_slot_count];
+            };
+
+            template <size_t... I>
+            constexpr option_slot_table create_option_slot_table(index_list<I...>)
+            {
+                return option_slot_table{ { static_cast<signed char>(find_option_for_slot(I, 0))... } };
+            }
+
+            constexpr option_slot_table option_slots = create_option_slot_table(make_index_list<option_slot_count>::type{});
+
+            const bootstrapper_option* find_bootstrapper_option(const dnx::char_t* name)
+            {
+                auto option_index = option_slots.option_index[option_slot(name)];
+                if (option_index < 0)
+                {
+                    return nullptr;
+                }
+
+                auto option = &bootstrapper_option_table[option_index];
+                return strings_equal_ignore_case(option->name, name) ? option : nullptr;
+            }
+        }
+
+        int get_bootstrapper_option_arg_count(const dnx::char_t* option_name)
+        {
+            auto option = find_bootstrapper_option(option_name);
+
+            // -1 - it isn't a bootstrapper option
+            return option ? option->arg_count : -1;
+        }
+
+        bootstrapper_options parse_bootstrapper_options(int argc, dnx::char_t** argv)
+        {
+            bootstrapper_options options;
+            options.first_non_bootstrapper_param_index = -1;
+            options.appbase_index = -1;
+            options.project_index = -1;
+            options.appbase = nullptr;
+            options.bootstrapper_debug = false;
+            options.perf_map = false;
+            options.cpus = nullptr;
+            options.numa_node = nullptr;
+            options.packages = nullptr;
+
+            for (int i = 0; i < argc; i++)
+            {
+                auto option = find_bootstrapper_option(argv[i]);
+                if (!option)
+                {
+                    options.first_non_bootstrapper_param_index = i;
+                    break;
+                }
+
+                switch (option->id)
+                {
+                case bootstrapper_option_id::appbase:
+                    if (options.appbase_index < 0)
+                    {
+                        options.appbase_index = i;
+                        // the value is missing if '--appbase' is the last argument
+                        options.appbase = i < argc - 1 ? argv[i + 1] : nullptr;
+                    }
+                    break;
+                case bootstrapper_option_id::project:
+                    if (options.project_index < 0)
+                    {
+                        options.project_index = i;
+                    }
+                    break;
+                case bootstrapper_option_id::bootstrapper_debug:
+                    options.bootstrapper_debug = true;
+                    break;
+                case bootstrapper_option_id::perf_map:
+                    options.perf_map = true;
+                    break;
+                case bootstrapper_option_id::cpus:
+                    options.cpus = i < argc - 1 ? argv[i + 1] : nullptr;
+                    break;
+                case bootstrapper_option_id::numa_node:
+                    options.numa_node = i < argc - 1 ? argv[i + 1] : nullptr;
+                    break;
+                case bootstrapper_option_id::packages:
+                    options.packages = i < argc - 1 ? argv[i + 1] : nullptr;
+                    break;
+                default:
+                    break;
+                }
+
+                i += option->arg_count;
+            }
+
+            return options;
         }
 
         int find_bootstrapper_option_index(int argc, dnx::char_t**argv, const dnx::char_t* optionName)
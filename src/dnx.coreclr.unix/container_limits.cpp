@@ -0,0 +1,274 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "container_limits.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(PLATFORM_LINUX)
+namespace
+{
+    // cgroup v1 reports a value close to INT64_MAX (rounded to the page size) when there is no memory limit
+    const uint64_t UNLIMITED_MEMORY_THRESHOLD = 1ull << 60;
+
+    struct cgroup_mount
+    {
+        std::string root;
+        std::string mount_point;
+    };
+
+    // The lines of mountinfo and cgroup - both limits are resolved from the same snapshot so that the files are
+    // read only once
+    struct cgroup_files
+    {
+        std::vector<std::string> mountinfo;
+        std::vector<std::string> cgroup;
+    };
+
+    std::vector<std::string> read_lines(const char* path)
+    {
+        std::vector<std::string> lines;
+        std::ifstream file(path);
+        for (std::string line; std::getline(file, line); )
+        {
+            lines.push_back(line);
+        }
+
+        return lines;
+    }
+
+    std::vector<std::string> split(const std::string& value, char separator)
+    {
+        std::vector<std::string> parts;
+        std::istringstream stream(value);
+        for (std::string part; std::getline(stream, part, separator); )
+        {
+            parts.push_back(part);
+        }
+
+        return parts;
+    }
+
+    bool contains(const std::vector<std::string>& values, const char* value)
+    {
+        for (auto& v : values)
+        {
+            if (v == value)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // controller - the name of the cgroup v1 controller or nullptr for the cgroup v2 (unified) hierarchy
+    //
+    // A mountinfo line looks like:
+    // 36 35 98:0 /root /mount/point rw,noatime master:1 - cgroup cgroup rw,memory
+    // (id, parent id, device, root, mount point, mount options, optional fields, '-', type, source, super options)
+    bool find_cgroup_mount(const std::vector<std::string>& mountinfo, const char* controller, cgroup_mount& mount)
+    {
+        for (auto& line : mountinfo)
+        {
+            auto fields = split(line, ' ');
+            size_t separator_index = 6;
+            while (separator_index < fields.size() && fields[separator_index] != "-")
+            {
+                separator_index++;
+            }
+
+            if (separator_index + 3 >= fields.size())
+            {
+                continue;
+            }
+
+            auto& type = fields[separator_index + 1];
+            auto found = controller
+                ? type == "cgroup" && contains(split(fields[separator_index + 3], ','), controller)
+                : type == "cgroup2";
+
+            if (found)
+            {
+                mount.root = fields[3];
+                mount.mount_point = fields[4];
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // A /proc/self/cgroup line looks like 'hierarchy-id:controller-list:cgroup-path' where the controller list
+    // is empty (and the hierarchy id is 0) for cgroup v2
+    bool find_cgroup_path(const std::vector<std::string>& cgroup, const char* controller, std::string& path)
+    {
+        for (auto& line : cgroup)
+        {
+            auto first_colon = line.find(':');
+            auto second_colon = first_colon == std::string::npos ? std::string::npos : line.find(':', first_colon + 1);
+            if (second_colon == std::string::npos)
+            {
+                continue;
+            }
+
+            auto controllers = line.substr(first_colon + 1, second_colon - first_colon - 1);
+            auto found = controller
+                ? contains(split(controllers, ','), controller)
+                : controllers.empty() && line.compare(0, first_colon, "0") == 0;
+
+            if (found)
+            {
+                path = line.substr(second_colon + 1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool find_cgroup_directory(const cgroup_files& files, const char* controller, std::string& directory)
+    {
+        cgroup_mount mount;
+        std::string path;
+        if (!find_cgroup_mount(files.mountinfo, controller, mount) || !find_cgroup_path(files.cgroup, controller, path))
+        {
+            return false;
+        }
+
+        // In a container the root of the mount is usually the cgroup of the container
+        if (mount.root != "/" && path.compare(0, mount.root.length(), mount.root) == 0)
+        {
+            path = path.substr(mount.root.length());
+        }
+
+        directory = mount.mount_point;
+        if (!path.empty() && path != "/")
+        {
+            directory.append(path);
+        }
+
+        return true;
+    }
+
+    bool read_line(const std::string& path, std::string& line)
+    {
+        std::ifstream file(path.c_str());
+        return static_cast<bool>(std::getline(file, line));
+    }
+
+    bool parse_uint64(const std::string& value, uint64_t& result)
+    {
+        if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+        {
+            return false;
+        }
+
+        result = strtoull(value.c_str(), nullptr, 10);
+        return true;
+    }
+
+    uint64_t get_memory_limit(const cgroup_files& files)
+    {
+        std::string directory, value;
+        uint64_t limit;
+
+        if (find_cgroup_directory(files, "memory", directory))
+        {
+            if (!read_line(directory + "/memory.limit_in_bytes", value) || !parse_uint64(value, limit) ||
+                limit >= UNLIMITED_MEMORY_THRESHOLD)
+            {
+                return 0;
+            }
+        }
+        else if (find_cgroup_directory(files, nullptr, directory))
+        {
+            // "max" if there is no limit
+            if (!read_line(directory + "/memory.max", value) || !parse_uint64(value, limit))
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            return 0;
+        }
+
+        auto physical_memory = static_cast<uint64_t>(sysconf(_SC_PHYS_PAGES)) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        return limit < physical_memory ? limit : 0;
+    }
+
+    unsigned int get_cpu_limit(const cgroup_files& files)
+    {
+        std::string directory, value;
+        uint64_t quota, period;
+
+        if (find_cgroup_directory(files, "cpu", directory))
+        {
+            // the quota is -1 if there is no limit
+            std::string period_value;
+            if (!read_line(directory + "/cpu.cfs_quota_us", value) || !parse_uint64(value, quota) ||
+                !read_line(directory + "/cpu.cfs_period_us", period_value) || !parse_uint64(period_value, period))
+            {
+                return 0;
+            }
+        }
+        else if (find_cgroup_directory(files, nullptr, directory))
+        {
+            // "$MAX $PERIOD" where $MAX is "max" if there is no limit
+            if (!read_line(directory + "/cpu.max", value))
+            {
+                return 0;
+            }
+
+            auto space = value.find(' ');
+            if (space == std::string::npos || !parse_uint64(value.substr(0, space), quota) ||
+                !parse_uint64(value.substr(space + 1), period))
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            return 0;
+        }
+
+        if (quota == 0 || period == 0)
+        {
+            return 0;
+        }
+
+        auto cpu_count = static_cast<unsigned int>((quota + period - 1) / period);
+        auto online_processors = sysconf(_SC_NPROCESSORS_ONLN);
+        return online_processors > 0 && cpu_count >= static_cast<unsigned int>(online_processors) ? 0 : cpu_count;
+    }
+}
+#endif
+
+namespace dnx
+{
+    container_limits get_container_limits()
+    {
+        return get_container_limits("/proc/self/mountinfo", "/proc/self/cgroup");
+    }
+
+    container_limits get_container_limits(const char* mountinfo_path, const char* cgroup_path)
+    {
+        container_limits limits;
+
+#if defined(PLATFORM_LINUX)
+        cgroup_files files{ read_lines(mountinfo_path), read_lines(cgroup_path) };
+        limits.cpu_count = get_cpu_limit(files);
+        limits.memory_limit = get_memory_limit(files);
+#else
+        // cgroups are Linux only
+        limits.cpu_count = 0;
+        limits.memory_limit = 0;
+#endif
+
+        return limits;
+    }
+}
@@ -0,0 +1,25 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace dnx
+{
+    // The resources available to the process as limited by the cgroup (v1 or v2) the process belongs to.
+    // A value of 0 means that there is no limit.
+    struct container_limits
+    {
+        // The CPU quota rounded up to whole processors (never more than the number of online processors)
+        unsigned int cpu_count;
+
+        // The memory limit in bytes (only set if lower than the physical memory)
+        uint64_t memory_limit;
+    };
+
+    container_limits get_container_limits();
+
+    // mountinfo_path and cgroup_path are the equivalents of /proc/self/mountinfo and /proc/self/cgroup
+    container_limits get_container_limits(const char* mountinfo_path, const char* cgroup_path);
+}
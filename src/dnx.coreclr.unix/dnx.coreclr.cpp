@@ -5,11 +5,33 @@
 #include "tpa.h"
 #include "utils.h"
 #include "app_main.h"
+#include "dnx_host.h"
+#include "trace_writer.h"
+#include "probes.h"
+#include "tpa_manifest.h"
+#include "container_limits.h"
+#include "process_placement.h"
+#include "runtime_properties.h"
+#include "startup_manifest.h"
+#include "packages_directory.h"
+#include "arena.h"
+#include "utf8.h"
+#include "target_framework.h"
+#include "prefetch.h"
+#include "trace_buffer.h"
+#include <algorithm>
 #include <assert.h>
+#include <dirent.h>
 #include <string>
 #include <vector>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <signal.h>
+#include <sstream>
+#include <unordered_set>
 #include <sys/utsname.h>
+#include <unistd.h>
 
 typedef int (*coreclr_initialize_fn)(
             const char* exePath,
@@ -32,26 +54,162 @@ typedef int (*coreclr_shutdown_fn)(
             void* hostHandle,
             unsigned int domainId);
 
-typedef int (*MultiByteToWideChar_fn)(
-            unsigned int CodePage,
-            int32_t dwFlags,
-            const char* lpMultiByteStr,
-            int cbMultiByte,
-            wchar_t* lpWideCharStr,
-            int cchWideChar);
-
 typedef int (*host_main_fn)(const int argc, const wchar_t** argv, const bootstrapper_context* ctx);
 
 #define BootstrapperName "Microsoft.Dnx.Host.CoreClr"
 
+// The failures of the host itself are reported like the failures of the runtime, as a failing HRESULT,
+// since the callers only check for negative results
+const int32_t E_FAIL = static_cast<int32_t>(0x80004005);
+
 namespace
 {
 
 void* pLibCoreClr = nullptr;
-MultiByteToWideChar_fn MultiByteToWideChar = nullptr;
 
-std::string GetPathToBootstrapper()
+// CoreCLR cannot be initialized again in a process where coreclr_initialize has been called
+bool coreclr_initialize_called = false;
+
+// The OS identity does not change for the lifetime of the process so it is resolved once
+struct os_identity
+{
+    bool resolved = false;
+    std::string operating_system;
+    std::string os_version;
+} os_identity_cache;
+
+// The placement applied by ApplyProcessPlacement
+dnx::process_placement applied_placement;
+
+bool IsTracingEnabled()
+{
+    char* dnxTraceEnv = getenv("DNX_TRACE");
+    return dnxTraceEnv != NULL && (strcmp(dnxTraceEnv, "1") == 0);
+}
+
+std::string GetTimingsFilePath()
+{
+    char* dnxTraceTimingsEnv = getenv("DNX_TRACE_TIMINGS");
+    return dnxTraceTimingsEnv != NULL ? std::string(dnxTraceTimingsEnv) : std::string();
+}
+
+// Opt-in with DNX_TRACE_BUFFER=1: the trace entries of the native host and the managed Logger are recorded in
+// a ring buffer that is written to stderr when the application exits or the process receives SIGUSR2
+bool IsTraceBufferEnabled()
+{
+    char* dnxTraceBufferEnv = getenv("DNX_TRACE_BUFFER");
+    return dnxTraceBufferEnv != NULL && (strcmp(dnxTraceBufferEnv, "1") == 0);
+}
+
+// 1 MB
+const size_t TraceBufferCapacity = 4096;
+
+// The runtime property with the address of WriteManagedTraceEvent
+#define TraceBufferPropertyKey "DNX_TRACE_BUFFER"
+
+// Never freed so that the signal handler cannot see a deleted buffer
+dnx::trace_buffer* trace_events = nullptr;
+
+void WriteNativeTraceEvent(const char* entry, size_t length)
+{
+    trace_events->write(dnx::trace_buffer::source::native, 3, entry, length);
+}
+
+// Called by the managed Logger through the function pointer in the DNX_TRACE_BUFFER runtime property
+extern "C" void WriteManagedTraceEvent(int level, const char16_t* message, int length)
+{
+    trace_events->write(dnx::trace_buffer::source::managed, level, message, length > 0 ? static_cast<size_t>(length) : 0);
+}
+
+void DumpTraceBuffer(int /*signal*/)
+{
+    trace_events->dump(STDERR_FILENO);
+}
+
+void CreateTraceBuffer(dnx::trace_writer& trace_writer)
+{
+    if (!trace_events)
+    {
+        trace_events = new dnx::trace_buffer(TraceBufferCapacity);
+
+        struct sigaction action = {};
+        action.sa_handler = &DumpTraceBuffer;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGUSR2, &action, nullptr);
+    }
+
+    trace_writer.set_sink(&WriteNativeTraceEvent);
+}
+
+// Opt-in with DNX_FAST_EXIT=1: the process exits as soon as the application returns instead of shutting down
+// the runtime and unloading libcoreclr. Finalizers and AppDomain.ProcessExit handlers do not run.
+bool IsFastExitEnabled()
+{
+    char* dnxFastExitEnv = getenv("DNX_FAST_EXIT");
+    return dnxFastExitEnv != NULL && (strcmp(dnxFastExitEnv, "1") == 0);
+}
+
+// '--perf-map' or DNX_PERF_MAP=1
+bool IsPerfMapEnabled(const CALL_APPLICATION_MAIN_DATA* data)
+{
+    char* dnxPerfMapEnv = getenv("DNX_PERF_MAP");
+    return data->perfMap || (dnxPerfMapEnv != NULL && (strcmp(dnxPerfMapEnv, "1") == 0));
+}
+
+// '--cpus' and '--numa-node' win over DNX_CPUS and DNX_NUMA_NODE
+// The runtime has no property for the CPUs or the NUMA node of the GC heaps - the affinity and the memory policy
+// of the thread that starts it are the only placement it follows.
+bool ApplyProcessPlacement(const CALL_APPLICATION_MAIN_DATA* data, dnx::trace_writer& trace_writer)
+{
+    auto cpus = data->cpus ? data->cpus : getenv("DNX_CPUS");
+    auto numa_node = data->numaNode ? data->numaNode : getenv("DNX_NUMA_NODE");
+    if (!cpus && !numa_node)
+    {
+        return true;
+    }
+
+    std::string error;
+    dnx::process_placement placement;
+    if (!dnx::resolve_process_placement(cpus, numa_node, placement, error) ||
+        !dnx::apply_process_placement(placement, error))
+    {
+        fprintf(stderr, "Failed to place the process: %s\n", error.c_str());
+        return false;
+    }
+
+    // The kernel leaves out the requested CPUs that are offline or outside of the cpuset of the process
+    auto affinity = dnx::get_cpu_affinity();
+    if (!placement.cpus.empty() && !affinity.empty())
+    {
+        placement.cpus = affinity;
+    }
+
+    applied_placement = placement;
+
+    std::ostringstream entry;
+    entry << "Process placement: cpus=" << dnx::format_cpu_list(affinity) << " numa-node=";
+    if (placement.numa_node >= 0)
+    {
+        entry << placement.numa_node << " (preferred)";
+    }
+    else
+    {
+        entry << "any";
+    }
+
+    trace_writer.write(entry.str(), true);
+    return true;
+}
+
+// The bootstrapper passes the path it has already resolved - the executable is only looked up for the hosting API
+std::string GetPathToBootstrapper(const CALL_APPLICATION_MAIN_DATA* data)
 {
+    if (data->bootstrapperPath)
+    {
+        return data->bootstrapperPath;
+    }
+
 #ifdef PLATFORM_DARWIN
     char pathToBootstrapper[PROC_PIDPATHINFO_MAXSIZE];
     ssize_t pathLen = proc_pidpath(getpid(), pathToBootstrapper, sizeof(pathToBootstrapper));
@@ -68,34 +226,62 @@ std::string GetPathToBootstrapper()
     return std::string(pathToBootstrapper);
 }
 
-bool GetTrustedPlatformAssembliesList(const std::string& tpaDirectory, bool isNative, std::string& trustedPlatformAssemblies)
+// Picks the native image of the assembly if it exists in the directory and falls back to the IL image otherwise
+bool SelectTrustedPlatformAssembly(const std::string& directory, const std::string& assembly_name, std::string& assembly_path, bool& is_native)
 {
-    //TODO: The Windows version of this actually ensures the files are present.  We just fail for native and assume MSIL is present
-    if (isNative)
-    {
-        return false;
-    }
+    const std::string il_extension = ".dll";
 
-    for (auto assembly_name : CreateTpaBase(isNative))
+    if (assembly_name.length() > il_extension.length() &&
+        assembly_name.compare(assembly_name.length() - il_extension.length(), il_extension.length(), il_extension) == 0)
     {
-        trustedPlatformAssemblies.append(dnx::utils::path_combine(tpaDirectory, assembly_name));
-        trustedPlatformAssemblies.append(":");
+        auto native_image_path = dnx::utils::path_combine(directory,
+            assembly_name.substr(0, assembly_name.length() - il_extension.length()).append(".ni.dll"));
+
+        if (dnx::utils::file_exists(native_image_path))
+        {
+            assembly_path = native_image_path;
+            is_native = true;
+            return true;
+        }
     }
 
-    return true;
+    assembly_path = dnx::utils::path_combine(directory, assembly_name);
+    is_native = false;
+    return dnx::utils::file_exists(assembly_path);
 }
 
-bool GetTrustedPlatformAssembliesList(const std::string& runtime_directory, std::string& trusted_assemblies)
+// Unlike on Windows native images are selected one assembly at a time so that a partially
+// crossgen'd runtime directory still benefits from the images it has. The directory is only
+// scanned when the persisted TPA manifest is missing or stale.
+bool GetTrustedPlatformAssembliesList(const std::string& tpaDirectory, std::string& trustedPlatformAssemblies, dnx::trace_writer& trace_writer)
 {
-        // Try native images first
-    if (!GetTrustedPlatformAssembliesList(runtime_directory, true, trusted_assemblies))
+    auto tpas = CreateTpaBase(false);
+    auto native_images_count = 0;
+
+    for (auto assembly_name : tpas)
     {
-        if (!GetTrustedPlatformAssembliesList(runtime_directory, false, trusted_assemblies))
+        std::string assembly_path;
+        bool is_native;
+
+        if (!SelectTrustedPlatformAssembly(tpaDirectory, assembly_name, assembly_path, is_native))
         {
+            trace_writer.write(std::string("Missing trusted platform assembly: ").append(assembly_path), false);
             return false;
         }
+
+        if (is_native)
+        {
+            native_images_count++;
+        }
+
+        trustedPlatformAssemblies.append(assembly_path);
+        trustedPlatformAssemblies.append(":");
     }
 
+    trace_writer.write(std::string("Using native images for ")
+        .append(std::to_string(native_images_count)).append(" of ")
+        .append(std::to_string(tpas.size())).append(" trusted platform assemblies"), true);
+
     return true;
 }
 
@@ -111,6 +297,7 @@ bool LoadCoreClrAtPath(const char* runtime_directory, void** ppLibCoreClr)
     auto coreclr_lib_path = dnx::utils::path_combine(runtime_directory, LIBCORECLR_NAME);
 
     *ppLibCoreClr = dlopen(coreclr_lib_path.c_str(), RTLD_NOW | RTLD_GLOBAL);
+    DNX_PROBE2(coreclr__load, coreclr_lib_path.c_str(), *ppLibCoreClr != nullptr);
 
     return *ppLibCoreClr != nullptr;
 }
@@ -142,102 +329,146 @@ int LoadCoreClr(const char* runtime_directory)
     return 0;
 }
 
-int32_t initialize_runtime(CALL_APPLICATION_MAIN_DATA* data, void **host_handle, unsigned int* domain_id)
+// Returns the value of the TRUSTED_PLATFORM_ASSEMBLIES property which points either to the mapped manifest
+// or to trusted_assemblies, or nullptr if the list could not be built
+const char* ResolveTrustedPlatformAssemblies(const char* runtime_directory, dnx::tpa_manifest& manifest,
+    std::string& trusted_assemblies, dnx::trace_writer& trace_writer)
 {
-    auto coreclr_initialize = (coreclr_initialize_fn)dlsym(pLibCoreClr, "coreclr_initialize");
-    if (!coreclr_initialize)
+    if (manifest.load(runtime_directory))
     {
-        fprintf(stderr, "Could not find coreclr_initialize entrypoint in coreclr\n");
-        return 1;
+        trace_writer.write("Using persisted TPA manifest", true);
+        return manifest.trusted_platform_assemblies();
     }
 
-    auto bootstrapper_path = GetPathToBootstrapper();
-
-    const char* property_keys[] =
-    {
-        "APPBASE",
-        "TRUSTED_PLATFORM_ASSEMBLIES",
-        "APP_PATHS",
-        "NATIVE_DLL_SEARCH_DIRECTORIES"
-    };
-
-    std::string trusted_assemblies;
-
-    if (!GetTrustedPlatformAssembliesList(data->runtimeDirectory, trusted_assemblies))
+    if (!GetTrustedPlatformAssembliesList(runtime_directory, trusted_assemblies, trace_writer))
     {
-        fprintf(stderr, "Failed to find files in the coreclr directory\n");
-        return 1;
+        return nullptr;
     }
 
     // Add the assembly containing the app domain manager to the trusted list
-    trusted_assemblies.append(dnx::utils::path_combine(data->runtimeDirectory, BootstrapperName ".dll"));
+    std::string bootstrapper_assembly_path;
+    bool is_native;
+    SelectTrustedPlatformAssembly(runtime_directory, BootstrapperName ".dll", bootstrapper_assembly_path, is_native);
+    trusted_assemblies.append(bootstrapper_assembly_path);
 
-    const char* property_values[] = {
-        // APPBASE
-        data->applicationBase,
-        // TRUESTED_PLATFORM_ASSEMBLIES
-        trusted_assemblies.c_str(),
-        // APP_PATHS
-        data->runtimeDirectory,
-        // NATIVE_DLL_SEARCH_DIRECTORIES
-        data->runtimeDirectory
-    };
+    if (dnx::tpa_manifest::save(runtime_directory, trusted_assemblies))
+    {
+        trace_writer.write("Persisted TPA manifest", true);
+    }
 
-    return coreclr_initialize(bootstrapper_path.c_str(), BootstrapperName, sizeof(property_keys) / sizeof(const char*),
-                property_keys, property_values, host_handle, domain_id);
+    return trusted_assemblies.c_str();
 }
 
-int32_t create_delegate(void *host_handle, unsigned int domain_id, void** delegate)
+// The runtime loaded by this host sizes the thread pool and the GC for the whole machine and has no property or
+// COMPlus_ setting to size it for the cgroup of the process (e.g. a container with a CPU quota) or its placement
+// ('--cpus'). The detected limits are only traced. Detection can be turned off with DNX_CONTAINER_LIMITS=0.
+void TraceContainerLimits(dnx::trace_writer& trace_writer)
 {
-    auto coreclr_create_delegate = (coreclr_create_delegate_fn)dlsym(pLibCoreClr, "coreclr_create_delegate");
-    if (!coreclr_create_delegate)
+    auto detection_env = getenv("DNX_CONTAINER_LIMITS");
+    auto detect = !detection_env || strcmp(detection_env, "0") != 0;
+
+    dnx::container_limits limits = { 0, 0 };
+    if (detect)
     {
-        fprintf(stderr, "Could not find coreclr_create_delegate entrypoint in coreclr\n");
-        return 1;
+        limits = dnx::get_container_limits();
     }
 
-    return coreclr_create_delegate(host_handle, domain_id, BootstrapperName", Version=0.0.0.0",
-            "DomainManager", "Execute", delegate);
+    // The process cannot use more CPUs than it has been placed on
+    auto placement_cpu_count = static_cast<unsigned int>(applied_placement.cpus.size());
+    if (placement_cpu_count > 0 && (limits.cpu_count == 0 || placement_cpu_count < limits.cpu_count))
+    {
+        limits.cpu_count = placement_cpu_count;
+    }
+
+    std::ostringstream entry;
+    entry << "Container limits: cpus=" << limits.cpu_count << " memory=" << limits.memory_limit
+        << (detect ? "" : " (detection disabled)");
+    trace_writer.write(entry.str(), true);
 }
 
-int32_t shutdown_runtime(void* host_handle, unsigned int domain_id)
+// The properties set by the host that cannot be changed by the runtime configuration
+const char* HostPropertyKeys[] =
 {
-    auto coreclr_shutdown = (coreclr_shutdown_fn)dlsym(pLibCoreClr, "coreclr_shutdown");
-    if (!coreclr_shutdown)
+    "APPBASE",
+    "TRUSTED_PLATFORM_ASSEMBLIES",
+    "APP_PATHS",
+    "APP_NI_PATHS",
+    "NATIVE_DLL_SEARCH_DIRECTORIES"
+};
+
+// The runtime configuration comes from runtimeconfig.json in the application base, overridden by the environment
+// variables
+bool GetConfigurableProperties(const char* application_base, dnx::runtime_properties& properties, dnx::trace_writer& trace_writer)
+{
+    auto config_path = dnx::utils::path_combine(application_base, "runtimeconfig.json");
+
+    std::string error;
+    if (!properties.load_config_file(config_path, error))
     {
-        fprintf(stderr, "Could not find coreclr_shutdown entrypoint in coreclr\n");
-        return 1;
+        fprintf(stderr, "Failed to load %s: %s\n", config_path.c_str(), error.c_str());
+        return false;
+    }
+
+    properties.apply_environment();
+
+    for (auto key : HostPropertyKeys)
+    {
+        if (properties.contains(key))
+        {
+            fprintf(stderr, "Ignoring the runtime property '%s' which is set by the host\n", key);
+            properties.remove(key);
+        }
+    }
+
+    // The value is called as a function by the managed Logger
+    if (properties.contains(TraceBufferPropertyKey))
+    {
+        fprintf(stderr, "Ignoring the runtime property '%s' which is set by the host\n", TraceBufferPropertyKey);
+        properties.remove(TraceBufferPropertyKey);
     }
 
-    return coreclr_shutdown(host_handle, domain_id);
+    for (auto& property : properties.items())
+    {
+        trace_writer.write(std::string("Runtime property: ").append(property.first).append("=").append(property.second), true);
+    }
+
+    return true;
 }
 
-// the caller is responsible for deleting the instance
-const wchar_t* to_wchar_t(const char* str)
+std::string ToLower(std::string value)
 {
-    auto length = MultiByteToWideChar(0 /*CP_ACP*/, 0, str, -1, nullptr, 0);
-    auto str_w = new wchar_t[length];
-    MultiByteToWideChar(0 /*CP_ACP*/, 0, str, length, str_w, length);
-    return str_w;
+    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+    return value;
 }
 
-int InvokeDelegate(host_main_fn host_main, int argc, const char** argv, const bootstrapper_context& ctx)
+// The names of the assemblies in the runtime directory. These are not taken from the startup manifest since
+// the host loads them from the runtime directory before the application assemblies are resolved.
+std::unordered_set<std::string> GetRuntimeAssemblyNames(const char* runtime_directory)
 {
-    const wchar_t** wchar_argv = new const wchar_t*[argc];
-    for (auto i = 0; i < argc; i++)
+    std::unordered_set<std::string> names;
+
+    auto dir = opendir(runtime_directory);
+    if (!dir)
     {
-        wchar_argv[i] = to_wchar_t(argv[i]);
+        return names;
     }
 
-    auto exit_code = host_main(argc, wchar_argv, &ctx);
-
-    for (auto i = 0; i < argc; i++)
+    while (auto entry = readdir(dir))
     {
-        delete[] wchar_argv[i];
+        std::string name(entry->d_name);
+        for (auto extension : { ".ni.dll", ".dll" })
+        {
+            auto extension_length = strlen(extension);
+            if (name.length() > extension_length && name.compare(name.length() - extension_length, extension_length, extension) == 0)
+            {
+                names.insert(ToLower(name.substr(0, name.length() - extension_length)));
+                break;
+            }
+        }
     }
-    delete[] wchar_argv;
 
-    return exit_code;
+    closedir(dir);
+    return names;
 }
 
 #if defined(PLATFORM_LINUX)
@@ -323,64 +554,374 @@ std::string translate_darwin_version(const std::string release)
 }
 #endif
 
-bootstrapper_context initialize_context(const CALL_APPLICATION_MAIN_DATA* data)
+void get_os_info(std::string& operating_system, std::string& os_version)
 {
-    bootstrapper_context ctx;
-
+#if defined(PLATFORM_LINUX)
+    // the kernel name is known at compile time - only the distribution needs to be looked up
+    operating_system = "Linux";
+    os_version = get_os_version();
+#else
     struct utsname uname_data;
     if (uname(&uname_data) == 0)
     {
-        ctx.operating_system = to_wchar_t(uname_data.sysname);
-
-#if defined(PLATFORM_DARWIN)
-        ctx.os_version = to_wchar_t(translate_darwin_version(uname_data.release).c_str());
-#endif
+        operating_system = uname_data.sysname;
+        os_version = translate_darwin_version(uname_data.release);
     }
     else
     {
         fprintf(stderr, "uname() failed using default os name and version.\n");
 
-        ctx.operating_system =
-#if defined(PLATFORM_LINUX)
-        to_wchar_t("Linux");
-#else
-        to_wchar_t("Darwin");
-        ctx.operating_system = to_wchar_t("10.1");
+        operating_system = "Darwin";
+        os_version = "10.1";
+    }
 #endif
+}
+
+void GetOsInfo(std::string& operating_system, std::string& os_version)
+{
+    if (!os_identity_cache.resolved)
+    {
+        get_os_info(os_identity_cache.operating_system, os_identity_cache.os_version);
+        os_identity_cache.resolved = true;
     }
 
-#if defined(PLATFORM_LINUX)
-    ctx.os_version = to_wchar_t(get_os_version().c_str());
-#endif
+    operating_system = os_identity_cache.operating_system;
+    os_version = os_identity_cache.os_version;
+}
+
+// Whether both paths point to the same existing directory
+bool IsSameDirectory(const char* path1, const std::string& path2)
+{
+    char real_path1[PATH_MAX];
+    char real_path2[PATH_MAX];
+    return realpath(path1, real_path1) && realpath(path2.c_str(), real_path2) && strcmp(real_path1, real_path2) == 0;
+}
+
+// Mirrors ServicingTable.GetServicingRoot - the patches of the servicing index are only applied by the managed host
+bool HasServicingIndex()
+{
+    std::string servicing_root;
+    if (auto servicing = getenv("DNX_SERVICING"))
+    {
+        servicing_root = servicing;
+    }
+    else
+    {
+        auto program_files = getenv("PROGRAMFILES(X86)");
+        if (!program_files)
+        {
+            program_files = getenv("PROGRAMFILES");
+        }
+
+        if (!program_files)
+        {
+            return false;
+        }
+
+        servicing_root = dnx::utils::path_combine(dnx::utils::path_combine(program_files, "Microsoft DNX"), "Servicing");
+    }
+
+    return dnx::utils::file_exists(dnx::utils::path_combine(servicing_root, "index.txt"));
+}
+
+// Appends the package assemblies and the native library directories dnu restore resolved for the application
+// (see StartupManifest.cs) so that the runtime binds them without calling into the managed loaders
+bool ApplyStartupManifest(const CALL_APPLICATION_MAIN_DATA* data, dnx::startup_manifest& manifest,
+    std::string& trusted_assemblies, std::string& native_dll_search_directories, dnx::trace_writer& trace_writer)
+{
+    // The managed host would resolve the packages from the directory given to the application host
+    if (data->packagesDirectory)
+    {
+        trace_writer.write("Ignoring startup manifest since a packages directory is passed with '--packages'", true);
+        return false;
+    }
+
+    if (!manifest.load(data->applicationBase))
+    {
+        return false;
+    }
+
+    // The runtime identifiers the manifest was resolved for are derived from the operating system, its version and
+    // the architecture. An unknown version (e.g. /etc/os-release could not be read) cannot be checked.
+    std::string operating_system, os_version;
+    GetOsInfo(operating_system, os_version);
+
+    if (os_version.empty() || operating_system != manifest.operating_system() ||
+        os_version != manifest.operating_system_version() || strcmp(manifest.architecture(), "x64") != 0)
+    {
+        trace_writer.write(std::string("Ignoring startup manifest restored for ").append(manifest.operating_system())
+            .append(" ").append(manifest.operating_system_version()).append(" ").append(manifest.architecture()), true);
+        return false;
+    }
+
+    // The paths point into the packages directory the application was restored to
+    if (!IsSameDirectory(manifest.packages_directory(), dnx::get_packages_directory(data->applicationBase)))
+    {
+        trace_writer.write(std::string("Ignoring startup manifest restored to ").append(manifest.packages_directory()), true);
+        return false;
+    }
+
+    if (HasServicingIndex())
+    {
+        trace_writer.write("Ignoring startup manifest since the servicing index applies to the package assemblies", true);
+        return false;
+    }
+
+    auto runtime_assemblies = GetRuntimeAssemblyNames(data->runtimeDirectory);
+
+    size_t added = 0;
+    for (auto& assembly : manifest.assemblies())
+    {
+        // Satellite assemblies and assemblies missing from the packages folder are left to the managed host
+        if (*assembly.culture || runtime_assemblies.count(ToLower(assembly.name)) || !dnx::utils::file_exists(assembly.path))
+        {
+            continue;
+        }
+
+        trusted_assemblies.append(":").append(assembly.path);
+        added++;
+    }
+
+    for (auto directory : manifest.native_library_directories())
+    {
+        native_dll_search_directories.append(":").append(directory);
+    }
+
+    trace_writer.write(std::string("Using startup manifest for ").append(manifest.target_framework()).append(": ")
+        .append(std::to_string(added)).append(" package assemblies, ")
+        .append(std::to_string(manifest.native_library_directories().size())).append(" native library directories"), true);
+
+    return true;
+}
+
+// The runtime reads the perf map knobs from the environment rather than from the properties passed to
+// coreclr_initialize. Values set by the user are left alone.
+void EnablePerfMap(dnx::trace_writer& trace_writer)
+{
+    setenv("COMPlus_PerfMapEnabled", "1", 0);
+    trace_writer.write(std::string("Perf map: COMPlus_PerfMapEnabled=").append(getenv("COMPlus_PerfMapEnabled")), true);
+}
+
+int32_t initialize_runtime(CALL_APPLICATION_MAIN_DATA* data, void **host_handle, unsigned int* domain_id, dnx::trace_writer& trace_writer)
+{
+    auto coreclr_initialize = (coreclr_initialize_fn)dlsym(pLibCoreClr, "coreclr_initialize");
+    if (!coreclr_initialize)
+    {
+        fprintf(stderr, "Could not find coreclr_initialize entrypoint in coreclr\n");
+        return E_FAIL;
+    }
+
+    auto bootstrapper_path = GetPathToBootstrapper(data);
+
+    TraceContainerLimits(trace_writer);
+
+    dnx::runtime_properties configurable_properties;
+    if (!GetConfigurableProperties(data->applicationBase, configurable_properties, trace_writer))
+    {
+        return E_FAIL;
+    }
+
+    // The manifest has to stay mapped until coreclr_initialize returns
+    dnx::tpa_manifest manifest;
+    std::string trusted_assemblies;
+    auto trusted_assemblies_value = ResolveTrustedPlatformAssemblies(data->runtimeDirectory, manifest, trusted_assemblies, trace_writer);
+
+    if (!trusted_assemblies_value)
+    {
+        fprintf(stderr, "Failed to find files in the coreclr directory\n");
+        return E_FAIL;
+    }
+
+    // Native images of application assemblies are probed for in the application base
+    auto app_ni_paths = std::string(data->applicationBase).append(":").append(data->runtimeDirectory);
+
+    dnx::startup_manifest startup_manifest;
+    std::string application_assemblies;
+    std::string native_dll_search_directories(data->runtimeDirectory);
+    if (ApplyStartupManifest(data, startup_manifest, application_assemblies, native_dll_search_directories, trace_writer))
+    {
+        trusted_assemblies_value = application_assemblies.insert(0, trusted_assemblies_value).c_str();
+    }
+
+    std::vector<const char*> property_keys(std::begin(HostPropertyKeys), std::end(HostPropertyKeys));
+    std::vector<const char*> property_values = {
+        // APPBASE
+        data->applicationBase,
+        // TRUESTED_PLATFORM_ASSEMBLIES
+        trusted_assemblies_value,
+        // APP_PATHS
+        data->runtimeDirectory,
+        // APP_NI_PATHS
+        app_ni_paths.c_str(),
+        // NATIVE_DLL_SEARCH_DIRECTORIES
+        native_dll_search_directories.c_str()
+    };
+
+    for (auto& property : configurable_properties.items())
+    {
+        property_keys.push_back(property.first.c_str());
+        property_values.push_back(property.second.c_str());
+    }
+
+    std::string trace_buffer_writer;
+    if (trace_events)
+    {
+        trace_buffer_writer = std::to_string(reinterpret_cast<uintptr_t>(&WriteManagedTraceEvent));
+        property_keys.push_back(TraceBufferPropertyKey);
+        property_values.push_back(trace_buffer_writer.c_str());
+    }
+
+    if (IsPerfMapEnabled(data))
+    {
+        EnablePerfMap(trace_writer);
+    }
+
+    coreclr_initialize_called = true;
+    auto result = coreclr_initialize(bootstrapper_path.c_str(), BootstrapperName, static_cast<int>(property_keys.size()),
+                property_keys.data(), property_values.data(), host_handle, domain_id);
+    DNX_PROBE2(runtime__initialize, data->applicationBase, result);
+    return result;
+}
+
+int32_t create_delegate(void *host_handle, unsigned int domain_id, void** delegate)
+{
+    auto coreclr_create_delegate = (coreclr_create_delegate_fn)dlsym(pLibCoreClr, "coreclr_create_delegate");
+    if (!coreclr_create_delegate)
+    {
+        fprintf(stderr, "Could not find coreclr_create_delegate entrypoint in coreclr\n");
+        return E_FAIL;
+    }
+
+    auto result = coreclr_create_delegate(host_handle, domain_id, BootstrapperName", Version=0.0.0.0",
+            "DomainManager", "Execute", delegate);
+    DNX_PROBE1(create__delegate, result);
+    return result;
+}
+
+int32_t shutdown_runtime(void* host_handle, unsigned int domain_id)
+{
+    auto coreclr_shutdown = (coreclr_shutdown_fn)dlsym(pLibCoreClr, "coreclr_shutdown");
+    if (!coreclr_shutdown)
+    {
+        fprintf(stderr, "Could not find coreclr_shutdown entrypoint in coreclr\n");
+        return E_FAIL;
+    }
+
+    auto result = coreclr_shutdown(host_handle, domain_id);
+    DNX_PROBE1(runtime__shutdown, result);
+    return result;
+}
+
+// The capacity needed to marshal str with to_wchar_t
+size_t wchar_t_size(const char* str)
+{
+    return dnx::arena::required_size<char16_t>(strlen(str) + 1);
+}
+
+// The managed host reads the strings as UTF-16 regardless of the size of wchar_t on the platform
+const wchar_t* to_wchar_t(const char* str, dnx::arena& arena)
+{
+    auto length = strlen(str);
+    auto str_w = arena.allocate<char16_t>(length + 1);
+    str_w[dnx::utf8::to_utf16(str, length, str_w)] = u'\0';
+    return reinterpret_cast<const wchar_t*>(str_w);
+}
+
+int InvokeDelegate(host_main_fn host_main, int argc, const char** argv, const bootstrapper_context& ctx, dnx::arena& arena)
+{
+    auto wchar_argv = arena.allocate<const wchar_t*>(argc);
+    for (auto i = 0; i < argc; i++)
+    {
+        wchar_argv[i] = to_wchar_t(argv[i], arena);
+    }
+
+    return host_main(argc, wchar_argv, &ctx);
+}
+
+// Selects the target framework from project.json so that the managed host does not need to JIT its JSON parser
+// on the startup path. Returns false if the managed host needs to select the framework.
+bool GetTargetFramework(const char* application_base, std::string& target_framework)
+{
+    target_framework.clear();
+
+    std::ifstream project_file(dnx::utils::path_combine(application_base, "project.json"), std::ios::in | std::ios::binary);
+    if (!project_file)
+    {
+        // the managed host uses the default framework
+        return true;
+    }
+
+    std::string project_json((std::istreambuf_iterator<char>(project_file)), std::istreambuf_iterator<char>());
+    return dnx::select_target_framework(project_json.c_str(), project_json.length(), target_framework);
+}
+
+bootstrapper_context initialize_context(const CALL_APPLICATION_MAIN_DATA* data, const std::string& operating_system,
+    const std::string& os_version, const char* target_framework, dnx::arena& arena)
+{
+    bootstrapper_context ctx;
+
+    ctx.operating_system = to_wchar_t(operating_system.c_str(), arena);
+    ctx.os_version = to_wchar_t(os_version.c_str(), arena);
 
     // currently we only support 64-bit Linux and Darwin
-    ctx.architecture = to_wchar_t("x64");
-    ctx.runtime_directory = to_wchar_t(data->runtimeDirectory);
-    ctx.application_base = to_wchar_t(data->applicationBase);
+    ctx.architecture = to_wchar_t("x64", arena);
+    ctx.runtime_directory = to_wchar_t(data->runtimeDirectory, arena);
+    ctx.application_base = to_wchar_t(data->applicationBase, arena);
+    ctx.target_framework = target_framework ? to_wchar_t(target_framework, arena) : nullptr;
 
     return ctx;
 }
 
-void clean_context(bootstrapper_context& ctx)
+int InvokeHostMain(host_main_fn host_main, const CALL_APPLICATION_MAIN_DATA* data, const std::string& operating_system,
+    const std::string& os_version)
 {
-    delete[] ctx.operating_system;
-    ctx.operating_system = nullptr;
-    delete[] ctx.architecture;
-    ctx.architecture = nullptr;
-    delete[] ctx.os_version;
-    ctx.os_version = nullptr;
-    delete[] ctx.runtime_directory;
-    ctx.runtime_directory = nullptr;
-    delete[] ctx.application_base;
-    ctx.application_base = nullptr;
+    std::string target_framework;
+    auto has_target_framework = GetTargetFramework(data->applicationBase, target_framework);
+
+    // the context and the arguments are marshalled into a single block that is freed when the application exits
+    auto arena_size = dnx::arena::required_size<const wchar_t*>(data->argc) + wchar_t_size(operating_system.c_str()) +
+        wchar_t_size(os_version.c_str()) + wchar_t_size("x64") + wchar_t_size(data->runtimeDirectory) +
+        wchar_t_size(data->applicationBase) + wchar_t_size(target_framework.c_str());
+    for (auto i = 0; i < data->argc; i++)
+    {
+        arena_size += wchar_t_size(data->argv[i]);
+    }
+
+    dnx::arena arena{ arena_size };
+    auto ctx = initialize_context(data, operating_system, os_version,
+        has_target_framework ? target_framework.c_str() : nullptr, arena);
+    auto exit_code = InvokeDelegate(host_main, data->argc, data->argv, ctx, arena);
+    DNX_PROBE1(app__exit, exit_code);
+    return exit_code;
 }
 
-int CallMain(CALL_APPLICATION_MAIN_DATA* data)
+// The managed host has flushed the console by the time host_main returns (see DomainManager.Execute) - only
+// the buffers of the native modules are left to flush before the process exits.
+[[noreturn]] void FastExit(int exit_code, dnx::trace_writer& trace_writer)
+{
+    trace_writer.write("Fast exit - skipping runtime shutdown", true);
+    DNX_PROBE1(fast__exit, exit_code);
+
+    fflush(stdout);
+    fflush(stderr);
+    xout.flush();
+
+    if (trace_events)
+    {
+        trace_events->dump(STDERR_FILENO);
+    }
+
+    _exit(exit_code);
+}
+
+int CallMain(CALL_APPLICATION_MAIN_DATA* data, dnx::trace_writer& trace_writer)
 {
     void* host_handle = nullptr;
     unsigned int domain_id;
 
-    auto result = initialize_runtime(data, &host_handle, &domain_id);
+    dnx::phase_timer initialize_timer{ trace_writer, "initialize_runtime" };
+    auto result = initialize_runtime(data, &host_handle, &domain_id, trace_writer);
+    initialize_timer.stop();
     if (result < 0)
     {
         fprintf(stderr, "Failed to initialize runtime: 0x%08x\n", result);
@@ -388,19 +929,33 @@ int CallMain(CALL_APPLICATION_MAIN_DATA* data)
     }
 
     void* host_main;
+    dnx::phase_timer create_delegate_timer{ trace_writer, "create_delegate" };
     result = create_delegate(host_handle, domain_id, &host_main);
+    create_delegate_timer.stop();
     if (result < 0)
     {
         fprintf(stderr, "Failed to create delegate: 0x%08x\n", result);
     }
     else
     {
-        auto ctx = initialize_context(data);
-        data->exitcode = InvokeDelegate((host_main_fn)host_main, data->argc, data->argv, ctx);
-        clean_context(ctx);
+        std::string operating_system, os_version;
+        dnx::phase_timer os_info_timer{ trace_writer, "GetOsInfo" };
+        GetOsInfo(operating_system, os_version);
+        os_info_timer.stop();
+
+        dnx::phase_timer invoke_timer{ trace_writer, "InvokeDelegate" };
+        data->exitcode = InvokeHostMain((host_main_fn)host_main, data, operating_system, os_version);
+        invoke_timer.stop();
+
+        if (IsFastExitEnabled())
+        {
+            FastExit(data->exitcode, trace_writer);
+        }
     }
 
+    dnx::phase_timer shutdown_timer{ trace_writer, "shutdown_runtime" };
     auto shutdown_result = shutdown_runtime(host_handle, domain_id);
+    shutdown_timer.stop();
     if (shutdown_result < 0)
     {
         fprintf(stderr, "Failed to shutdown runtime: 0x%08x\n", shutdown_result);
@@ -409,29 +964,187 @@ int CallMain(CALL_APPLICATION_MAIN_DATA* data)
 
     return result;
 }
+
+// The process wide setup shared by dnx and the hosting API: the trace buffer (DNX_TRACE_BUFFER=1) and the placement
+// ('--cpus'/'--numa-node' or DNX_CPUS/DNX_NUMA_NODE). Has to be called before any thread is started - threads
+// inherit the placement of the thread that starts them.
+bool SetupProcess(const CALL_APPLICATION_MAIN_DATA* data, dnx::trace_writer& trace_writer)
+{
+    if (IsTraceBufferEnabled())
+    {
+        CreateTraceBuffer(trace_writer);
+    }
+
+    return ApplyProcessPlacement(data, trace_writer);
+}
+
+// Reads ahead the files the runtime is about to load while libcoreclr is loaded and initialized. The
+// returned thread is joined when it goes out of scope.
+std::unique_ptr<dnx::prefetch_thread> StartPrefetch(const char* runtime_directory, const char* application_base,
+    dnx::trace_writer& trace_writer)
+{
+    if (!dnx::prefetch::is_enabled())
+    {
+        trace_writer.write("Prefetch disabled (DNX_PREFETCH=1 turns it on)", true);
+        return nullptr;
+    }
+
+    return std::unique_ptr<dnx::prefetch_thread>(new dnx::prefetch_thread(runtime_directory, application_base));
+}
 }
 
 extern "C" int CallApplicationMain(CALL_APPLICATION_MAIN_DATA* data)
 {
-    if (LoadCoreClr(data->runtimeDirectory) != 0)
+    auto trace_writer = dnx::trace_writer{ IsTracingEnabled(), GetTimingsFilePath() };
+    if (!SetupProcess(data, trace_writer))
     {
         return 1;
     }
 
-    int result = 0;
+    auto prefetch = StartPrefetch(data->runtimeDirectory, data->applicationBase, trace_writer);
+
+    dnx::phase_timer load_timer{ trace_writer, "LoadCoreClr" };
+    auto load_result = LoadCoreClr(data->runtimeDirectory);
+    load_timer.stop();
 
-    MultiByteToWideChar = (MultiByteToWideChar_fn)dlsym(pLibCoreClr, "MultiByteToWideChar");
-    if (!MultiByteToWideChar)
+    if (load_result != 0)
     {
-        fprintf(stderr, "Could not find MultiByteToWideChar entrypoint in coreclr\n");
-        result = 1;
+        return 1;
     }
-    else
+
+    auto result = CallMain(data, trace_writer);
+
+    FreeCoreClr();
+
+    if (trace_events)
     {
-        result = CallMain(data);
+        trace_events->dump(STDERR_FILENO);
     }
 
+    return result;
+}
+
+struct dnx_host
+{
+    std::string runtime_directory;
+    std::string application_base;
+    std::string operating_system;
+    std::string os_version;
+    void* host_handle;
+    unsigned int domain_id;
+    host_main_fn host_main;
+};
+
+extern "C" int dnx_host_create(const char* runtime_directory, const char* application_base, dnx_host** host)
+{
+    if (!runtime_directory || !application_base || !host)
+    {
+        return 1;
+    }
+
+    *host = nullptr;
+
+    if (coreclr_initialize_called)
+    {
+        fprintf(stderr, "A dnx host has already been created in this process\n");
+        return 1;
+    }
+
+    auto new_host = new dnx_host();
+    new_host->runtime_directory = runtime_directory;
+    new_host->application_base = application_base;
+
+    CALL_APPLICATION_MAIN_DATA data = { 0 };
+    data.runtimeDirectory = new_host->runtime_directory.c_str();
+    data.applicationBase = new_host->application_base.c_str();
+
+    auto trace_writer = dnx::trace_writer{ IsTracingEnabled(), GetTimingsFilePath() };
+    if (!SetupProcess(&data, trace_writer))
+    {
+        delete new_host;
+        return 1;
+    }
+
+    auto prefetch = StartPrefetch(runtime_directory, application_base, trace_writer);
+
+    dnx::phase_timer load_timer{ trace_writer, "LoadCoreClr" };
+    auto load_result = LoadCoreClr(runtime_directory);
+    load_timer.stop();
+
+    if (load_result != 0)
+    {
+        delete new_host;
+        return 1;
+    }
+
+    dnx::phase_timer initialize_timer{ trace_writer, "initialize_runtime" };
+    auto result = initialize_runtime(&data, &new_host->host_handle, &new_host->domain_id, trace_writer);
+    initialize_timer.stop();
+    if (result != 0)
+    {
+        fprintf(stderr, "Failed to initialize runtime: 0x%08x\n", result);
+        delete new_host;
+        FreeCoreClr();
+        return 1;
+    }
+
+    void* host_main;
+    dnx::phase_timer create_delegate_timer{ trace_writer, "create_delegate" };
+    result = create_delegate(new_host->host_handle, new_host->domain_id, &host_main);
+    create_delegate_timer.stop();
+    if (result != 0)
+    {
+        fprintf(stderr, "Failed to create delegate: 0x%08x\n", result);
+        shutdown_runtime(new_host->host_handle, new_host->domain_id);
+        delete new_host;
+        FreeCoreClr();
+        return 1;
+    }
+
+    new_host->host_main = (host_main_fn)host_main;
+    GetOsInfo(new_host->operating_system, new_host->os_version);
+
+    *host = new_host;
+    return 0;
+}
+
+extern "C" int dnx_host_execute(dnx_host* host, int argc, const char** argv, int* exit_code)
+{
+    if (!host || argc < 0 || (argc > 0 && !argv) || !exit_code)
+    {
+        return 1;
+    }
+
+    CALL_APPLICATION_MAIN_DATA data = { 0 };
+    data.runtimeDirectory = host->runtime_directory.c_str();
+    data.applicationBase = host->application_base.c_str();
+    data.argc = argc;
+    data.argv = argv;
+
+    *exit_code = InvokeHostMain(host->host_main, &data, host->operating_system, host->os_version);
+    return 0;
+}
+
+extern "C" int dnx_host_destroy(dnx_host* host)
+{
+    if (!host)
+    {
+        return 1;
+    }
+
+    auto result = shutdown_runtime(host->host_handle, host->domain_id);
+    if (result < 0)
+    {
+        fprintf(stderr, "Failed to shutdown runtime: 0x%08x\n", result);
+    }
+
+    delete host;
     FreeCoreClr();
 
-    return result;
+    if (trace_events)
+    {
+        trace_events->dump(STDERR_FILENO);
+    }
+
+    return result < 0 ? 1 : 0;
 }
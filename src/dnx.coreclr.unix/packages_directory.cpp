@@ -0,0 +1,92 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "packages_directory.h"
+#include "json_scanner.h"
+#include "utils.h"
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    bool read_file(const std::string& path, std::string& content)
+    {
+        std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    // The parent of "/x" is "/", the root has no parent
+    std::string get_parent_directory(const std::string& path)
+    {
+        if (path.length() <= 1)
+        {
+            return std::string();
+        }
+
+        auto separator = path.find_last_of('/', path.length() - 2);
+        if (separator == std::string::npos)
+        {
+            return std::string();
+        }
+
+        return separator == 0 ? std::string("/") : path.substr(0, separator);
+    }
+}
+
+namespace dnx
+{
+    std::string get_packages_directory(const std::string& application_base)
+    {
+        for (auto directory = application_base; !directory.empty(); directory = get_parent_directory(directory))
+        {
+            std::string content;
+            if (!read_file(dnx::utils::path_combine(directory, "global.json"), content))
+            {
+                continue;
+            }
+
+            dnx::json::scanner scanner(content.c_str(), content.length());
+            if (scanner.next() != dnx::json::token_type::begin_object)
+            {
+                break;
+            }
+
+            while (scanner.next() == dnx::json::token_type::string)
+            {
+                auto is_packages = scanner.string_equals("packages");
+                if (scanner.next() == dnx::json::token_type::string && is_packages)
+                {
+                    auto packages = scanner.token_value();
+                    return packages[0] == '/' ? packages : dnx::utils::path_combine(directory, packages);
+                }
+
+                if (!scanner.skip_value())
+                {
+                    break;
+                }
+            }
+
+            // global.json is the root of the solution - there is no need to look further
+            break;
+        }
+
+        for (auto variable : { "NUGET_PACKAGES", "DNX_PACKAGES" })
+        {
+            auto packages = getenv(variable);
+            if (packages && *packages)
+            {
+                return packages;
+            }
+        }
+
+        auto home = getenv("HOME");
+        return home ? std::string(home).append("/.nuget/packages") : std::string();
+    }
+}
@@ -0,0 +1,14 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <string>
+
+namespace dnx
+{
+    // The directory the packages of the application are resolved from. Mirrors
+    // PackageDependencyProvider.ResolveRepositoryPath: the "packages" property of global.json, NUGET_PACKAGES,
+    // DNX_PACKAGES and ~/.nuget/packages. Returns an empty string if none of these is set.
+    std::string get_packages_directory(const std::string& application_base);
+}
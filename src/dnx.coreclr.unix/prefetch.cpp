@@ -0,0 +1,280 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "prefetch.h"
+#include "json_scanner.h"
+#include "packages_directory.h"
+#include "tpa.h"
+#include "tpa_manifest.h"
+#include "utils.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    const char* RUNTIME_LIBRARIES[] =
+    {
+#if defined(PLATFORM_DARWIN)
+        "libcoreclr.dylib",
+        "libclrjit.dylib",
+#else
+        "libcoreclr.so",
+        "libclrjit.so",
+#endif
+        "Microsoft.Dnx.Host.CoreClr.dll",
+        "Microsoft.Dnx.Host.CoreClr.ni.dll"
+    };
+
+    bool read_file(const std::string& path, std::string& content)
+    {
+        std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    // Adds the "runtime" assemblies of the packages in the first DNXCore target of the lock file:
+    // "targets": { "DNXCore,Version=v5.0": { "Id/Version": { "type": "package", "runtime": { "lib/x.dll": {} } } } }
+    void add_lock_file_assemblies(const std::string& application_base, std::vector<std::string>& files)
+    {
+        std::string content;
+        if (!read_file(dnx::utils::path_combine(application_base, "project.lock.json"), content))
+        {
+            return;
+        }
+
+        auto packages_directory = dnx::get_packages_directory(application_base);
+        if (packages_directory.empty())
+        {
+            return;
+        }
+
+        dnx::json::scanner scanner(content.c_str(), content.length());
+        if (scanner.next() != dnx::json::token_type::begin_object)
+        {
+            return;
+        }
+
+        // Find "targets"
+        for (;;)
+        {
+            if (scanner.next() != dnx::json::token_type::string)
+            {
+                return;
+            }
+
+            auto is_targets = scanner.string_equals("targets");
+            if (scanner.next() == dnx::json::token_type::begin_object && is_targets)
+            {
+                break;
+            }
+
+            if (!scanner.skip_value())
+            {
+                return;
+            }
+        }
+
+        // Find the target
+        for (;;)
+        {
+            if (scanner.next() != dnx::json::token_type::string)
+            {
+                return;
+            }
+
+            auto target = scanner.token_value();
+            if (scanner.next() != dnx::json::token_type::begin_object)
+            {
+                return;
+            }
+
+            // targets with a runtime identifier (e.g. "DNXCore,Version=v5.0/ubuntu.14.04-x64") are not used by dnx
+            if (target.compare(0, 7, "DNXCore") == 0 && target.find('/') == std::string::npos)
+            {
+                break;
+            }
+
+            if (!scanner.skip_value())
+            {
+                return;
+            }
+        }
+
+        // The libraries of the target
+        while (scanner.next() == dnx::json::token_type::string)
+        {
+            auto library = scanner.token_value();
+            if (scanner.next() != dnx::json::token_type::begin_object)
+            {
+                return;
+            }
+
+            auto is_package = false;
+            std::vector<std::string> runtime_assemblies;
+
+            while (scanner.next() == dnx::json::token_type::string)
+            {
+                auto is_type = scanner.string_equals("type");
+                auto is_runtime = scanner.string_equals("runtime");
+                auto token = scanner.next();
+
+                if (is_type && token == dnx::json::token_type::string)
+                {
+                    is_package = scanner.string_equals("package");
+                }
+                else if (is_runtime && token == dnx::json::token_type::begin_object)
+                {
+                    while (scanner.next() == dnx::json::token_type::string)
+                    {
+                        runtime_assemblies.push_back(scanner.token_value());
+                        scanner.next();
+                        if (!scanner.skip_value())
+                        {
+                            return;
+                        }
+                    }
+                }
+                else if (!scanner.skip_value())
+                {
+                    return;
+                }
+            }
+
+            // project references are compiled in memory
+            auto separator = library.find('/');
+            if (!is_package || separator == std::string::npos)
+            {
+                continue;
+            }
+
+            auto package_directory = dnx::utils::path_combine(
+                dnx::utils::path_combine(packages_directory, library.substr(0, separator)), library.substr(separator + 1));
+
+            for (auto& assembly : runtime_assemblies)
+            {
+                files.push_back(dnx::utils::path_combine(package_directory, assembly));
+            }
+        }
+    }
+}
+
+namespace dnx
+{
+    namespace prefetch
+    {
+        std::vector<std::string> get_startup_files(const std::string& runtime_directory, const std::string& application_base)
+        {
+            std::vector<std::string> files;
+
+            for (auto library : RUNTIME_LIBRARIES)
+            {
+                files.push_back(dnx::utils::path_combine(runtime_directory, library));
+            }
+
+            dnx::tpa_manifest manifest;
+            if (manifest.load(runtime_directory))
+            {
+                std::string tpa(manifest.trusted_platform_assemblies());
+                for (size_t start = 0, end; start < tpa.length(); start = end + 1)
+                {
+                    end = tpa.find(':', start);
+                    if (end == std::string::npos)
+                    {
+                        end = tpa.length();
+                    }
+
+                    if (end > start)
+                    {
+                        files.push_back(tpa.substr(start, end - start));
+                    }
+                }
+            }
+            else
+            {
+                // Either the IL image or the native image of each assembly is loaded
+                for (auto native_images : { true, false })
+                {
+                    for (auto assembly : CreateTpaBase(native_images))
+                    {
+                        files.push_back(dnx::utils::path_combine(runtime_directory, assembly));
+                    }
+                }
+            }
+
+            add_lock_file_assemblies(application_base, files);
+
+            return files;
+        }
+
+        size_t read_ahead(const std::vector<std::string>& files)
+        {
+            size_t found = 0;
+
+            for (auto& file : files)
+            {
+                auto fd = open(file.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    continue;
+                }
+
+                found++;
+
+#if defined(PLATFORM_DARWIN)
+                // Darwin has no posix_fadvise - F_RDADVISE starts reading the given range asynchronously
+                struct stat file_stat;
+                if (fstat(fd, &file_stat) == 0)
+                {
+                    struct radvisory advisory;
+                    advisory.ra_offset = 0;
+                    advisory.ra_count = static_cast<int>(file_stat.st_size);
+                    fcntl(fd, F_RDADVISE, &advisory);
+                }
+#else
+                posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+
+                close(fd);
+            }
+
+            return found;
+        }
+
+        bool is_enabled()
+        {
+            auto prefetch = getenv("DNX_PREFETCH");
+            return prefetch && strcmp(prefetch, "1") == 0;
+        }
+    }
+
+    prefetch_thread::prefetch_thread(const std::string& runtime_directory, const std::string& application_base)
+    {
+        try
+        {
+            m_thread = std::thread([runtime_directory, application_base]()
+            {
+                prefetch::read_ahead(prefetch::get_startup_files(runtime_directory, application_base));
+            });
+        }
+        catch (const std::system_error&)
+        {
+            // prefetching is an optimization - the application starts without it if the thread cannot be created
+        }
+    }
+
+    prefetch_thread::~prefetch_thread()
+    {
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+}
@@ -0,0 +1,41 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dnx
+{
+    namespace prefetch
+    {
+        // The files read when the application starts: the runtime libraries, the trusted platform assemblies
+        // and the runtime assemblies of the packages listed in project.lock.json of the application. Files that
+        // do not exist are included - they are skipped when read ahead.
+        std::vector<std::string> get_startup_files(const std::string& runtime_directory, const std::string& application_base);
+
+        // Asks the kernel to read the files into the page cache. Returns the number of files found.
+        size_t read_ahead(const std::vector<std::string>& files);
+
+        // Prefetching is turned on with DNX_PREFETCH=1. It is off by default - when the files are already in the
+        // page cache (e.g. every start but the first) the extra thread and opens only add to the startup time.
+        bool is_enabled();
+    }
+
+    // Reads ahead the startup files on a background thread so that the disk I/O overlaps with the runtime
+    // initialization. The thread is joined when the instance is destroyed.
+    class prefetch_thread
+    {
+    public:
+        prefetch_thread(const std::string& runtime_directory, const std::string& application_base);
+        ~prefetch_thread();
+
+    private:
+        prefetch_thread(const prefetch_thread&) = delete;
+        prefetch_thread& operator=(const prefetch_thread&) = delete;
+
+        std::thread m_thread;
+    };
+}
@@ -0,0 +1,210 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "process_placement.h"
+#include <algorithm>
+#include <errno.h>
+#include <fstream>
+#include <sstream>
+
+#if defined(PLATFORM_LINUX)
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+namespace
+{
+    // The memory policy modes of set_mempolicy (linux/mempolicy.h) - the system call is made directly so that
+    // the host does not depend on libnuma
+    const int MPOL_PREFERRED_MODE = 1;
+
+    bool parse_int(const std::string& value, int& result)
+    {
+        if (value.empty() || value.length() > 6 || value.find_first_not_of("0123456789") != std::string::npos)
+        {
+            return false;
+        }
+
+        result = atoi(value.c_str());
+        return true;
+    }
+
+    std::string to_error(const char* operation)
+    {
+        return std::string(operation).append(" failed: ").append(strerror(errno));
+    }
+}
+
+namespace dnx
+{
+    bool parse_cpu_list(const std::string& value, std::vector<int>& cpus)
+    {
+        std::vector<int> result;
+        std::istringstream stream(value);
+        for (std::string range; std::getline(stream, range, ','); )
+        {
+            auto dash = range.find('-');
+            int first, last;
+            if (!parse_int(range.substr(0, dash), first) ||
+                !parse_int(dash == std::string::npos ? range : range.substr(dash + 1), last) || first > last)
+            {
+                return false;
+            }
+
+#if defined(PLATFORM_LINUX)
+            if (last >= CPU_SETSIZE)
+            {
+                return false;
+            }
+#endif
+
+            for (auto cpu = first; cpu <= last; cpu++)
+            {
+                result.push_back(cpu);
+            }
+        }
+
+        if (result.empty())
+        {
+            return false;
+        }
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        cpus.swap(result);
+        return true;
+    }
+
+    std::string format_cpu_list(const std::vector<int>& cpus)
+    {
+        std::string list;
+        for (size_t i = 0; i < cpus.size(); )
+        {
+            auto last = i;
+            while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1)
+            {
+                last++;
+            }
+
+            if (!list.empty())
+            {
+                list.append(",");
+            }
+
+            list.append(std::to_string(cpus[i]));
+            if (last > i)
+            {
+                list.append("-").append(std::to_string(cpus[last]));
+            }
+
+            i = last + 1;
+        }
+
+        return list;
+    }
+
+    bool resolve_process_placement(const char* cpus, const char* numa_node, process_placement& placement, std::string& error)
+    {
+        if (numa_node)
+        {
+            if (!parse_int(numa_node, placement.numa_node))
+            {
+                error = std::string("Invalid NUMA node: ").append(numa_node);
+                return false;
+            }
+
+            // The CPUs of the node are the default for the CPUs of the process
+            auto cpulist_path = std::string("/sys/devices/system/node/node").append(numa_node).append("/cpulist");
+            std::ifstream cpulist(cpulist_path.c_str());
+            std::string node_cpus;
+            if (!std::getline(cpulist, node_cpus))
+            {
+                error = std::string("NUMA node ").append(numa_node).append(" does not exist");
+                return false;
+            }
+
+            if (!cpus && !parse_cpu_list(node_cpus, placement.cpus))
+            {
+                error = std::string("NUMA node ").append(numa_node).append(" has no CPUs");
+                return false;
+            }
+        }
+
+        if (cpus && !parse_cpu_list(cpus, placement.cpus))
+        {
+            error = std::string("Invalid CPU list: ").append(cpus);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool apply_process_placement(const process_placement& placement, std::string& error)
+    {
+#if defined(PLATFORM_LINUX)
+        if (!placement.cpus.empty())
+        {
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            for (auto cpu : placement.cpus)
+            {
+                CPU_SET(cpu, &cpu_set);
+            }
+
+            if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+            {
+                error = to_error("sched_setaffinity");
+                return false;
+            }
+        }
+
+        if (placement.numa_node >= 0)
+        {
+            // Preferred rather than bound - when the node runs out of memory the allocations fall back to the other
+            // nodes instead of failing
+            const size_t bits_per_word = sizeof(unsigned long) * 8;
+            std::vector<unsigned long> node_mask(placement.numa_node / bits_per_word + 1);
+            node_mask[placement.numa_node / bits_per_word] |= 1ul << (placement.numa_node % bits_per_word);
+
+            // the kernel reads maxnode - 1 bits
+            if (syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, node_mask.data(), node_mask.size() * bits_per_word + 1) != 0)
+            {
+                error = to_error("set_mempolicy");
+                return false;
+            }
+        }
+
+        return true;
+#else
+        if (placement.cpus.empty() && placement.numa_node < 0)
+        {
+            return true;
+        }
+
+        error = "CPU affinity and NUMA placement are not supported on this platform";
+        return false;
+#endif
+    }
+
+    std::vector<int> get_cpu_affinity()
+    {
+        std::vector<int> cpus;
+
+#if defined(PLATFORM_LINUX)
+        cpu_set_t cpu_set;
+        if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+        {
+            for (auto cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            {
+                if (CPU_ISSET(cpu, &cpu_set))
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+
+        return cpus;
+    }
+}
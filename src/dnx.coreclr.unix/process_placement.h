@@ -0,0 +1,38 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace dnx
+{
+    // The CPUs and the NUMA node the process is placed on ('--cpus' and '--numa-node')
+    struct process_placement
+    {
+        // The CPUs the threads of the process run on, empty if not restricted
+        std::vector<int> cpus;
+
+        // The NUMA node memory is allocated from, -1 if not restricted
+        int numa_node = -1;
+    };
+
+    // Parses a CPU list in the format of taskset -c and /sys/devices/system/node/node<N>/cpulist e.g. "0-3,8,10-11".
+    // The result is sorted and has no duplicates.
+    bool parse_cpu_list(const std::string& value, std::vector<int>& cpus);
+
+    // The inverse of parse_cpu_list - consecutive CPUs are written as ranges
+    std::string format_cpu_list(const std::vector<int>& cpus);
+
+    // cpus and numa_node are the values of the options, nullptr if not set. If only the NUMA node is given the
+    // process runs on the CPUs of the node. Returns false and sets error if a value is invalid.
+    bool resolve_process_placement(const char* cpus, const char* numa_node, process_placement& placement, std::string& error);
+
+    // Sets the CPU affinity and the memory policy of the calling thread. Threads inherit them from the thread that
+    // starts them so this has to be called before the process starts any other thread.
+    bool apply_process_placement(const process_placement& placement, std::string& error);
+
+    // The CPUs the calling thread is allowed to run on, empty if not known
+    std::vector<int> get_cpu_affinity();
+}
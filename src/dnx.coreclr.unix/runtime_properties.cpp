@@ -0,0 +1,194 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "runtime_properties.h"
+#include "json_scanner.h"
+#include <fstream>
+#include <iterator>
+#include <strings.h>
+
+namespace
+{
+    struct environment_knob
+    {
+        const char* variable;
+        const char* property;
+    };
+
+    // Only the properties the runtime reads - other settings are not known to it
+    const environment_knob environment_knobs[] =
+    {
+        { "DNX_GC_SERVER", "System.GC.Server" },
+        { "DNX_GC_CONCURRENT", "System.GC.Concurrent" },
+    };
+
+    // The knobs accept 1/0 in addition to true/false
+    std::string normalize_boolean(const char* value)
+    {
+        if (strcmp(value, "1") == 0 || strcasecmp(value, "true") == 0)
+        {
+            return "true";
+        }
+
+        if (strcmp(value, "0") == 0 || strcasecmp(value, "false") == 0)
+        {
+            return "false";
+        }
+
+        return value;
+    }
+}
+
+namespace dnx
+{
+    void runtime_properties::set(const std::string& key, const std::string& value)
+    {
+        for (auto& property : m_properties)
+        {
+            if (property.first == key)
+            {
+                property.second = value;
+                return;
+            }
+        }
+
+        m_properties.push_back(std::make_pair(key, value));
+    }
+
+    void runtime_properties::remove(const std::string& key)
+    {
+        for (auto it = m_properties.begin(); it != m_properties.end(); ++it)
+        {
+            if (it->first == key)
+            {
+                m_properties.erase(it);
+                return;
+            }
+        }
+    }
+
+    bool runtime_properties::contains(const std::string& key) const
+    {
+        for (auto& property : m_properties)
+        {
+            if (property.first == key)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool runtime_properties::load_config_file(const std::string& path, std::string& error)
+    {
+        std::ifstream config_file(path.c_str(), std::ios::in | std::ios::binary);
+        if (!config_file)
+        {
+            return true;
+        }
+
+        std::string content((std::istreambuf_iterator<char>(config_file)), std::istreambuf_iterator<char>());
+        json::scanner scanner(content.c_str(), content.length());
+
+        if (scanner.next() != json::token_type::begin_object)
+        {
+            error = "The root of the runtime configuration file must be an object";
+            return false;
+        }
+
+        for (auto token = scanner.next(); token != json::token_type::end_object; token = scanner.next())
+        {
+            if (token != json::token_type::string)
+            {
+                error = "Malformed runtime configuration file at offset " + std::to_string(scanner.position());
+                return false;
+            }
+
+            auto is_config_properties = scanner.string_equals("configProperties");
+            scanner.next();
+
+            if (!is_config_properties)
+            {
+                if (!scanner.skip_value())
+                {
+                    error = "Malformed runtime configuration file at offset " + std::to_string(scanner.position());
+                    return false;
+                }
+
+                continue;
+            }
+
+            if (scanner.current() != json::token_type::begin_object)
+            {
+                error = "'configProperties' must be an object";
+                return false;
+            }
+
+            for (token = scanner.next(); token != json::token_type::end_object; token = scanner.next())
+            {
+                if (token != json::token_type::string)
+                {
+                    error = "Malformed runtime configuration file at offset " + std::to_string(scanner.position());
+                    return false;
+                }
+
+                auto key = scanner.token_value();
+                switch (scanner.next())
+                {
+                case json::token_type::string:
+                case json::token_type::number:
+                case json::token_type::true_value:
+                case json::token_type::false_value:
+                    set(key, scanner.token_value());
+                    break;
+                default:
+                    error = "The value of the runtime property '" + key + "' must be a string, a number or a boolean";
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void runtime_properties::apply_environment()
+    {
+        for (auto& knob : environment_knobs)
+        {
+            auto value = getenv(knob.variable);
+            if (value && *value)
+            {
+                set(knob.property, normalize_boolean(value));
+            }
+        }
+
+        auto properties = getenv("DNX_RUNTIME_PROPERTIES");
+        if (!properties)
+        {
+            return;
+        }
+
+        std::string remaining(properties);
+        while (!remaining.empty())
+        {
+            auto separator = remaining.find(';');
+            auto property = remaining.substr(0, separator);
+            remaining = separator == std::string::npos ? std::string() : remaining.substr(separator + 1);
+
+            auto equals = property.find('=');
+            if (equals == std::string::npos || equals == 0)
+            {
+                if (!property.empty())
+                {
+                    fprintf(stderr, "Ignoring the malformed runtime property '%s' in DNX_RUNTIME_PROPERTIES\n", property.c_str());
+                }
+
+                continue;
+            }
+
+            set(property.substr(0, equals), property.substr(equals + 1));
+        }
+    }
+}
@@ -0,0 +1,40 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dnx
+{
+    // The properties passed to coreclr_initialize in the order they were first set
+    class runtime_properties
+    {
+    public:
+        // Adds the property or replaces its value if it has already been set
+        void set(const std::string& key, const std::string& value);
+
+        void remove(const std::string& key);
+
+        bool contains(const std::string& key) const;
+
+        const std::vector<std::pair<std::string, std::string>>& items() const
+        {
+            return m_properties;
+        }
+
+        // Loads the "configProperties" object of a runtime configuration file, e.g.:
+        // { "configProperties": { "System.GC.Server": true, "System.GC.Concurrent": false } }
+        // Returns true if the file does not exist. error is set if the file is malformed.
+        bool load_config_file(const std::string& path, std::string& error);
+
+        // Applies the environment variables overriding the runtime configuration - DNX_GC_SERVER and
+        // DNX_GC_CONCURRENT (1/0 or true/false) and DNX_RUNTIME_PROPERTIES ("key1=value1;key2=value2")
+        void apply_environment();
+
+    private:
+        std::vector<std::pair<std::string, std::string>> m_properties;
+    };
+}
@@ -0,0 +1,240 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "startup_manifest.h"
+#include "utils.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace
+{
+    const char* MANIFEST_FILE_NAME = "project.lock.startup";
+    const char MANIFEST_MAGIC[8] = { 'D', 'N', 'X', 'S', 'T', 'M', '0', '3' };
+
+    struct file_stamp
+    {
+        int64_t length;
+        int64_t mtime_sec;
+    };
+
+    struct manifest_header
+    {
+        char magic[8];
+        file_stamp project_file;
+        file_stamp lock_file;
+    };
+
+    // Mirrors StartupManifest.GetStamp - files that do not exist are stamped with -1
+    file_stamp get_file_stamp(const std::string& path)
+    {
+        struct stat file_stat;
+        if (stat(path.c_str(), &file_stat) != 0)
+        {
+            return file_stamp{ -1, -1 };
+        }
+
+        return file_stamp{ static_cast<int64_t>(file_stat.st_size), static_cast<int64_t>(file_stat.st_mtime) };
+    }
+
+    bool stamps_equal(const file_stamp& s1, const file_stamp& s2)
+    {
+        return s1.length == s2.length && s1.mtime_sec == s2.mtime_sec;
+    }
+
+    // Values in the manifest are not aligned
+    class manifest_reader
+    {
+    public:
+        manifest_reader(const char* position, const char* end)
+            : m_position(position), m_end(end)
+        {}
+
+        bool read_uint32(uint32_t& value)
+        {
+            if (static_cast<size_t>(m_end - m_position) < sizeof(value))
+            {
+                return false;
+            }
+
+            memcpy(&value, m_position, sizeof(value));
+            m_position += sizeof(value);
+            return true;
+        }
+
+        bool read_string(const char*& value)
+        {
+            uint32_t length;
+            if (!read_uint32(length) || static_cast<size_t>(m_end - m_position) <= length || m_position[length] != '\0')
+            {
+                return false;
+            }
+
+            value = m_position;
+            m_position += length + 1;
+            return true;
+        }
+
+        bool at_end() const
+        {
+            return m_position == m_end;
+        }
+
+    private:
+        const char* m_position;
+        const char* m_end;
+    };
+}
+
+namespace dnx
+{
+    startup_manifest::startup_manifest()
+        : m_data(nullptr), m_size(0), m_target_framework(nullptr), m_operating_system(nullptr),
+        m_operating_system_version(nullptr), m_architecture(nullptr), m_packages_directory(nullptr)
+    {}
+
+    startup_manifest::~startup_manifest()
+    {
+        unmap();
+    }
+
+    void startup_manifest::unmap()
+    {
+        if (m_data)
+        {
+            munmap(m_data, m_size);
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        m_target_framework = nullptr;
+        m_operating_system = nullptr;
+        m_operating_system_version = nullptr;
+        m_architecture = nullptr;
+        m_packages_directory = nullptr;
+        m_assemblies.clear();
+        m_native_library_directories.clear();
+    }
+
+    bool startup_manifest::load(const std::string& application_base)
+    {
+        unmap();
+
+        auto fd = open(dnx::utils::path_combine(application_base, MANIFEST_FILE_NAME).c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat manifest_stat;
+        if (fstat(fd, &manifest_stat) != 0 || manifest_stat.st_size <= static_cast<off_t>(sizeof(manifest_header)))
+        {
+            close(fd);
+            return false;
+        }
+
+        auto size = static_cast<size_t>(manifest_stat.st_size);
+        auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        m_data = data;
+        m_size = size;
+
+        manifest_header header;
+        memcpy(&header, m_data, sizeof(header));
+
+        if (memcmp(header.magic, MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC)) != 0 ||
+            !stamps_equal(header.project_file, get_file_stamp(dnx::utils::path_combine(application_base, "project.json"))) ||
+            !stamps_equal(header.lock_file, get_file_stamp(dnx::utils::path_combine(application_base, "project.lock.json"))) ||
+            !parse())
+        {
+            unmap();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool startup_manifest::parse()
+    {
+        auto data = static_cast<const char*>(m_data);
+        manifest_reader reader(data + sizeof(manifest_header), data + m_size);
+
+        if (!reader.read_string(m_target_framework) ||
+            !reader.read_string(m_operating_system) ||
+            !reader.read_string(m_operating_system_version) ||
+            !reader.read_string(m_architecture) ||
+            !reader.read_string(m_packages_directory))
+        {
+            return false;
+        }
+
+        // The runtime identifiers are only checked by the managed host - the native host compares the operating
+        // system version they are derived from
+        uint32_t count;
+        if (!reader.read_uint32(count))
+        {
+            return false;
+        }
+
+        for (; count > 0; count--)
+        {
+            const char* runtime_identifier;
+            if (!reader.read_string(runtime_identifier))
+            {
+                return false;
+            }
+        }
+
+        if (!reader.read_uint32(count))
+        {
+            return false;
+        }
+
+        // each entry takes at least 30 bytes - a corrupt count must not turn into a huge allocation
+        m_assemblies.reserve(std::min<size_t>(count, m_size / 30));
+        for (; count > 0; count--)
+        {
+            // The package and the path in the package are only used by the managed host to apply the
+            // servicing index
+            assembly entry;
+            const char* package_id;
+            const char* package_version;
+            const char* asset_path;
+            if (!reader.read_string(entry.name) || !reader.read_string(entry.culture) ||
+                !reader.read_string(package_id) || !reader.read_string(package_version) ||
+                !reader.read_string(asset_path) || !reader.read_string(entry.path))
+            {
+                return false;
+            }
+
+            m_assemblies.push_back(entry);
+        }
+
+        if (!reader.read_uint32(count))
+        {
+            return false;
+        }
+
+        for (; count > 0; count--)
+        {
+            const char* directory;
+            if (!reader.read_string(directory))
+            {
+                return false;
+            }
+
+            m_native_library_directories.push_back(directory);
+        }
+
+        return reader.at_end();
+    }
+}
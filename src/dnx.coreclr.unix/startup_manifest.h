@@ -0,0 +1,87 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace dnx
+{
+    // The package assemblies and native library directories of an application resolved by dnu restore. The
+    // format is written by StartupManifest.cs. The manifest is stamped with the size and modification time of
+    // project.json and project.lock.json and is only valid as long as neither file has changed. The paths are
+    // the paths in the packages directory the application was restored to, before servicing.
+    class startup_manifest
+    {
+    public:
+        struct assembly
+        {
+            const char* name;
+            const char* culture;
+            const char* path;
+        };
+
+        startup_manifest();
+        ~startup_manifest();
+
+        // Maps the manifest from the application base. Returns false if the manifest does not exist, is
+        // malformed or is stale.
+        bool load(const std::string& application_base);
+
+        // The values point into the mapped manifest and are valid until the instance is destroyed
+        const char* target_framework() const
+        {
+            return m_target_framework;
+        }
+
+        const char* operating_system() const
+        {
+            return m_operating_system;
+        }
+
+        // The distribution and its version on Linux (ID and VERSION_ID of /etc/os-release) the runtime identifiers
+        // were resolved for
+        const char* operating_system_version() const
+        {
+            return m_operating_system_version;
+        }
+
+        const char* architecture() const
+        {
+            return m_architecture;
+        }
+
+        const char* packages_directory() const
+        {
+            return m_packages_directory;
+        }
+
+        const std::vector<assembly>& assemblies() const
+        {
+            return m_assemblies;
+        }
+
+        const std::vector<const char*>& native_library_directories() const
+        {
+            return m_native_library_directories;
+        }
+
+    private:
+        startup_manifest(const startup_manifest&) = delete;
+        startup_manifest& operator=(const startup_manifest&) = delete;
+
+        bool parse();
+        void unmap();
+
+        void* m_data;
+        size_t m_size;
+        const char* m_target_framework;
+        const char* m_operating_system;
+        const char* m_operating_system_version;
+        const char* m_architecture;
+        const char* m_packages_directory;
+        std::vector<assembly> m_assemblies;
+        std::vector<const char*> m_native_library_directories;
+    };
+}
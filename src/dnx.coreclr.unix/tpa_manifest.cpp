@@ -0,0 +1,185 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "tpa_manifest.h"
+#include "utils.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace
+{
+    const char* MANIFEST_FILE_NAME = "dnx.coreclr.tpa";
+    const char MANIFEST_MAGIC[8] = { 'D', 'N', 'X', 'T', 'P', 'A', '0', '1' };
+
+    struct directory_stamp
+    {
+        uint64_t device;
+        uint64_t inode;
+        int64_t mtime_sec;
+        int64_t mtime_nsec;
+    };
+
+    // layout: manifest_header, the list of assemblies (tpa_length bytes), '\0'
+    struct manifest_header
+    {
+        char magic[8];
+        directory_stamp stamp;
+        uint64_t tpa_length;
+    };
+
+    bool get_directory_stamp(const std::string& directory, directory_stamp& stamp)
+    {
+        struct stat dir_stat;
+        if (stat(directory.c_str(), &dir_stat) != 0 || !S_ISDIR(dir_stat.st_mode))
+        {
+            return false;
+        }
+
+        stamp.device = static_cast<uint64_t>(dir_stat.st_dev);
+        stamp.inode = static_cast<uint64_t>(dir_stat.st_ino);
+#if defined(PLATFORM_DARWIN)
+        stamp.mtime_sec = static_cast<int64_t>(dir_stat.st_mtimespec.tv_sec);
+        stamp.mtime_nsec = static_cast<int64_t>(dir_stat.st_mtimespec.tv_nsec);
+#else
+        stamp.mtime_sec = static_cast<int64_t>(dir_stat.st_mtim.tv_sec);
+        stamp.mtime_nsec = static_cast<int64_t>(dir_stat.st_mtim.tv_nsec);
+#endif
+        return true;
+    }
+
+    bool stamps_equal(const directory_stamp& s1, const directory_stamp& s2)
+    {
+        return s1.device == s2.device && s1.inode == s2.inode &&
+            s1.mtime_sec == s2.mtime_sec && s1.mtime_nsec == s2.mtime_nsec;
+    }
+
+    bool write_all(int fd, const char* buffer, size_t count)
+    {
+        while (count > 0)
+        {
+            auto written = write(fd, buffer, count);
+            if (written < 0)
+            {
+                return false;
+            }
+
+            buffer += written;
+            count -= static_cast<size_t>(written);
+        }
+
+        return true;
+    }
+}
+
+namespace dnx
+{
+    tpa_manifest::tpa_manifest()
+        : m_data(nullptr), m_size(0), m_trusted_platform_assemblies(nullptr)
+    {}
+
+    tpa_manifest::~tpa_manifest()
+    {
+        unmap();
+    }
+
+    void tpa_manifest::unmap()
+    {
+        if (m_data)
+        {
+            munmap(m_data, m_size);
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        m_trusted_platform_assemblies = nullptr;
+    }
+
+    bool tpa_manifest::load(const std::string& runtime_directory)
+    {
+        unmap();
+
+        directory_stamp stamp;
+        if (!get_directory_stamp(runtime_directory, stamp))
+        {
+            return false;
+        }
+
+        auto fd = open(dnx::utils::path_combine(runtime_directory, MANIFEST_FILE_NAME).c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat manifest_stat;
+        if (fstat(fd, &manifest_stat) != 0 || manifest_stat.st_size <= static_cast<off_t>(sizeof(manifest_header)))
+        {
+            close(fd);
+            return false;
+        }
+
+        auto size = static_cast<size_t>(manifest_stat.st_size);
+        auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        m_data = data;
+        m_size = size;
+
+        auto header = static_cast<const manifest_header*>(m_data);
+        auto tpa = static_cast<const char*>(m_data) + sizeof(manifest_header);
+
+        if (memcmp(header->magic, MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC)) != 0 ||
+            header->tpa_length != size - sizeof(manifest_header) - 1 ||
+            tpa[header->tpa_length] != '\0' ||
+            !stamps_equal(header->stamp, stamp))
+        {
+            unmap();
+            return false;
+        }
+
+        m_trusted_platform_assemblies = tpa;
+        return true;
+    }
+
+    bool tpa_manifest::save(const std::string& runtime_directory, const std::string& trusted_platform_assemblies)
+    {
+        auto manifest_path = dnx::utils::path_combine(runtime_directory, MANIFEST_FILE_NAME);
+        auto temp_path = std::string(manifest_path).append(".").append(std::to_string(getpid()));
+
+        auto fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        // The stamp is written after the manifest has been moved to its final location since
+        // creating and renaming the file changes the modification time of the runtime directory
+        manifest_header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC));
+        header.tpa_length = trusted_platform_assemblies.length();
+
+        auto written = write_all(fd, reinterpret_cast<const char*>(&header), sizeof(header)) &&
+            write_all(fd, trusted_platform_assemblies.c_str(), trusted_platform_assemblies.length() + 1);
+
+        if (!written || rename(temp_path.c_str(), manifest_path.c_str()) != 0)
+        {
+            close(fd);
+            unlink(temp_path.c_str());
+            return false;
+        }
+
+        auto stamped = get_directory_stamp(runtime_directory, header.stamp) &&
+            pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+
+        close(fd);
+        return stamped;
+    }
+}
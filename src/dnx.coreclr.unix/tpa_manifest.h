@@ -0,0 +1,44 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <string>
+
+namespace dnx
+{
+    // The trusted platform assemblies list persisted in the runtime directory. The manifest is stamped
+    // with the identity and the modification time of the runtime directory and is only valid as long as
+    // the directory has not changed.
+    class tpa_manifest
+    {
+    public:
+        tpa_manifest();
+        ~tpa_manifest();
+
+        // Maps the manifest from the runtime directory. Returns false if the manifest does not exist,
+        // is malformed or is stale.
+        bool load(const std::string& runtime_directory);
+
+        // The mapped list, valid until the instance is destroyed. The value can be passed directly as
+        // the TRUSTED_PLATFORM_ASSEMBLIES property.
+        const char* trusted_platform_assemblies() const
+        {
+            return m_trusted_platform_assemblies;
+        }
+
+        // Writes the manifest to the runtime directory. Failures (e.g. a read-only runtime directory) are
+        // not fatal - the list will just be rebuilt on the next start.
+        static bool save(const std::string& runtime_directory, const std::string& trusted_platform_assemblies);
+
+    private:
+        tpa_manifest(const tpa_manifest&) = delete;
+        tpa_manifest& operator=(const tpa_manifest&) = delete;
+
+        void unmap();
+
+        void* m_data;
+        size_t m_size;
+        const char* m_trusted_platform_assemblies;
+    };
+}
@@ -0,0 +1,249 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "trace_buffer.h"
+#include <chrono>
+#include <pthread.h>
+#include <type_traits>
+
+#if defined(PLATFORM_LINUX)
+#include <sys/syscall.h>
+#endif
+
+namespace
+{
+    uint32_t current_thread_id()
+    {
+        static thread_local uint32_t thread_id = 0;
+        if (thread_id == 0)
+        {
+#if defined(PLATFORM_LINUX)
+            thread_id = static_cast<uint32_t>(syscall(SYS_gettid));
+#else
+            uint64_t id;
+            pthread_threadid_np(nullptr, &id);
+            thread_id = static_cast<uint32_t>(id);
+#endif
+        }
+
+        return thread_id;
+    }
+
+    uint64_t now_ns()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // A line of the dump is formatted on the stack since malloc is not async-signal-safe
+    class line_writer
+    {
+    public:
+        void append(const char* value)
+        {
+            while (*value)
+            {
+                append_char(*value++);
+            }
+        }
+
+        void append(uint64_t value)
+        {
+            char digits[20];
+            auto count = 0;
+            do
+            {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value > 0);
+
+            while (count > 0)
+            {
+                append_char(digits[--count]);
+            }
+        }
+
+        // UTF-8 - unpaired surrogates are written as '?'
+        void append(const char16_t* value, size_t length)
+        {
+            for (size_t i = 0; i < length; i++)
+            {
+                uint32_t c = value[i];
+                if (c >= 0xD800 && c <= 0xDBFF && i + 1 < length && value[i + 1] >= 0xDC00 && value[i + 1] <= 0xDFFF)
+                {
+                    c = 0x10000 + ((c - 0xD800) << 10) + (value[++i] - 0xDC00);
+                }
+                else if (c >= 0xD800 && c <= 0xDFFF)
+                {
+                    c = '?';
+                }
+
+                if (c < 0x80)
+                {
+                    // keep an event on a single line
+                    append_char(c == '\n' || c == '\r' ? ' ' : static_cast<char>(c));
+                }
+                else if (c < 0x800)
+                {
+                    append_char(static_cast<char>(0xC0 | (c >> 6)));
+                    append_char(static_cast<char>(0x80 | (c & 0x3F)));
+                }
+                else if (c < 0x10000)
+                {
+                    append_char(static_cast<char>(0xE0 | (c >> 12)));
+                    append_char(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                    append_char(static_cast<char>(0x80 | (c & 0x3F)));
+                }
+                else
+                {
+                    append_char(static_cast<char>(0xF0 | (c >> 18)));
+                    append_char(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+                    append_char(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                    append_char(static_cast<char>(0x80 | (c & 0x3F)));
+                }
+            }
+        }
+
+        void flush(int fd)
+        {
+            size_t written = 0;
+            while (written < m_length)
+            {
+                auto result = ::write(fd, m_buffer + written, m_length - written);
+                if (result <= 0)
+                {
+                    break;
+                }
+
+                written += static_cast<size_t>(result);
+            }
+
+            m_length = 0;
+        }
+
+    private:
+        void append_char(char c)
+        {
+            if (m_length < sizeof(m_buffer))
+            {
+                m_buffer[m_length++] = c;
+            }
+        }
+
+        // an event is at most 4 bytes per character of the message plus the fixed fields
+        char m_buffer[dnx::trace_buffer::message_capacity * 4 + 128];
+        size_t m_length = 0;
+    };
+
+    size_t round_up_to_power_of_two(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+}
+
+namespace dnx
+{
+    trace_buffer::trace_buffer(size_t capacity)
+        : m_events(new event[round_up_to_power_of_two(capacity)]), m_mask(round_up_to_power_of_two(capacity) - 1), m_next(0)
+    {
+        for (size_t i = 0; i <= m_mask; i++)
+        {
+            m_events[i].sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void trace_buffer::write(source source, int level, const char* message, size_t length)
+    {
+        write_event(source, level, message, length);
+    }
+
+    void trace_buffer::write(source source, int level, const char16_t* message, size_t length)
+    {
+        write_event(source, level, message, length);
+    }
+
+    template<typename TChar>
+    void trace_buffer::write_event(source source, int level, const TChar* message, size_t length)
+    {
+        // Each writer gets a slot of its own - writers only contend on this increment
+        auto index = m_next.fetch_add(1, std::memory_order_relaxed);
+        auto& e = m_events[index & m_mask];
+
+        // A reader that sees the old sequence number after this store sees neither the old nor the new payload as
+        // valid (see dump)
+        e.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        e.timestamp_ns = now_ns();
+        e.thread_id = current_thread_id();
+        e.source = static_cast<uint8_t>(source);
+        e.level = static_cast<uint8_t>(level);
+        e.length = static_cast<uint16_t>(length < message_capacity ? length : message_capacity);
+        for (size_t i = 0; i < e.length; i++)
+        {
+            // char is widened byte by byte - the native messages are ASCII
+            e.message[i] = static_cast<char16_t>(static_cast<typename std::make_unsigned<TChar>::type>(message[i]));
+        }
+
+        e.sequence.store(index + 1, std::memory_order_release);
+    }
+
+    void trace_buffer::dump(int fd) const
+    {
+        auto next = m_next.load(std::memory_order_acquire);
+        auto capacity = static_cast<uint64_t>(m_mask) + 1;
+        auto first = next > capacity ? next - capacity : 0;
+
+        line_writer line;
+        line.append("dnx trace buffer: ");
+        line.append(next - first);
+        line.append(" of ");
+        line.append(next);
+        line.append(" events\n");
+        line.flush(fd);
+
+        for (auto index = first; index < next; index++)
+        {
+            auto& e = m_events[index & m_mask];
+            if (e.sequence.load(std::memory_order_acquire) != index + 1)
+            {
+                continue;
+            }
+
+            // copied first and only used if the event was not overwritten while it was being copied
+            auto timestamp_ns = e.timestamp_ns;
+            auto thread_id = e.thread_id;
+            auto event_source = e.source;
+            auto level = e.level;
+            auto length = e.length < message_capacity ? e.length : message_capacity;
+            char16_t message[message_capacity];
+            for (size_t i = 0; i < length; i++)
+            {
+                message[i] = e.message[i];
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (e.sequence.load(std::memory_order_relaxed) != index + 1)
+            {
+                continue;
+            }
+
+            line.append(timestamp_ns);
+            line.append(event_source == static_cast<uint8_t>(source::managed) ? " managed " : " native ");
+            line.append(static_cast<uint64_t>(thread_id));
+            line.append(" ");
+            line.append(static_cast<uint64_t>(level));
+            line.append(" ");
+            line.append(message, length);
+            line.append("\n");
+            line.flush(fd);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace dnx
+{
+    // A fixed size ring of binary trace events written without locks by any thread of the native host and, through
+    // the DNX_TRACE_BUFFER runtime property, by the managed Logger. When the ring is full the oldest events are
+    // overwritten. The events are only formatted when the buffer is dumped.
+    class trace_buffer
+    {
+    public:
+        enum class source : uint8_t
+        {
+            native = 0,
+            managed = 1
+        };
+
+        // Longer messages are truncated
+        static const size_t message_capacity = 116;
+
+        // capacity - the number of events, rounded up to a power of two
+        explicit trace_buffer(size_t capacity);
+
+        // level - 1 (error), 2 (warning) or 3 (information), the levels of the managed Logger
+        void write(source source, int level, const char* message, size_t length);
+        void write(source source, int level, const char16_t* message, size_t length);
+
+        // Writes the events in the buffer, oldest first, as text lines to fd. Only async-signal-safe functions are
+        // called so that the buffer can be dumped from a signal handler. Events being written at the same time are
+        // skipped.
+        void dump(int fd) const;
+
+    private:
+        // 256 bytes
+        struct event
+        {
+            // index + 1 once the event has been written, 0 while it is being written
+            std::atomic<uint64_t> sequence;
+            uint64_t timestamp_ns; // CLOCK_MONOTONIC, the clock of dnx::phase_timer
+            uint32_t thread_id;
+            uint8_t source;
+            uint8_t level;
+            uint16_t length;
+            char16_t message[message_capacity];
+        };
+
+        template<typename TChar>
+        void write_event(source source, int level, const TChar* message, size_t length);
+
+        trace_buffer(const trace_buffer&) = delete;
+        trace_buffer& operator=(const trace_buffer&) = delete;
+
+        std::unique_ptr<event[]> m_events;
+        size_t m_mask;
+        std::atomic<uint64_t> m_next;
+    };
+}
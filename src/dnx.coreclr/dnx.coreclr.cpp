@@ -7,6 +7,9 @@
 #include "utils.h"
 #include "trace_writer.h"
 #include "app_main.h"
+#include "target_framework.h"
+#include <fstream>
+#include <iterator>
 
 typedef int (STDMETHODCALLTYPE *HostMain)(const int argc, const wchar_t** argv, const bootstrapper_context* ctx);
 
@@ -17,6 +20,31 @@ std::wstring GetModuleDirectory(HMODULE module)
     return dnx::utils::remove_file_from_path(buffer);
 }
 
+// Selects the target framework from project.json so that the managed host does not need to JIT its JSON parser
+// on the startup path. Returns false if the managed host needs to select the framework.
+bool GetTargetFramework(const std::wstring& application_base, std::wstring& target_framework)
+{
+    target_framework.clear();
+
+    std::ifstream project_file(dnx::utils::path_combine(application_base, L"project.json"), std::ios::in | std::ios::binary);
+    if (!project_file)
+    {
+        // the managed host uses the default framework
+        return true;
+    }
+
+    std::string project_json((std::istreambuf_iterator<char>(project_file)), std::istreambuf_iterator<char>());
+    std::string framework;
+    if (!dnx::select_target_framework(project_json.c_str(), project_json.length(), framework))
+    {
+        return false;
+    }
+
+    // the frameworks supported by CoreCLR have ASCII names
+    target_framework.assign(framework.begin(), framework.end());
+    return true;
+}
+
 // Generate a list of trusted platform assemblies.
 bool GetTrustedPlatformAssembliesList(const std::wstring& runtime_directory, bool bNative, std::wstring& tpa_paths)
 {
@@ -245,11 +273,15 @@ HRESULT ExecuteMain(ICLRRuntimeHost2* pCLRRuntimeHost, PCALL_APPLICATION_MAIN_DA
 
     dnx::utils::wait_for_debugger(data->argc, data->argv, L"--debug");
 
+    std::wstring target_framework;
+    auto has_target_framework = GetTargetFramework(data->applicationBase, target_framework);
+
     bootstrapper_context ctx;
     ctx.operating_system = L"Windows";
     ctx.os_version = windows_version.c_str();
     ctx.runtime_directory = data->runtimeDirectory;
     ctx.application_base = data->applicationBase;
+    ctx.target_framework = has_target_framework ? target_framework.c_str() : nullptr;
 #if defined(AMD64)
     ctx.architecture = L"x64";
 #elif defined(ARM)
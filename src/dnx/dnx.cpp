@@ -2,10 +2,11 @@
 // Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
 
 #include "stdafx.h"
-#include <vector>
+#include "arena.h"
 #include "pal.h"
 #include "utils.h"
 #include "app_main.h"
+#include "probes.h"
 
 bool string_ends_with_ignore_case(const dnx::char_t* s, const dnx::char_t* suffix)
 {
@@ -33,41 +34,58 @@ int split_path(const dnx::char_t* path)
     return -1;
 }
 
-const dnx::char_t* allocate_and_copy(const dnx::char_t* value, size_t count)
+// The expanded arguments point to the original arguments or to string literals - only the application base
+// derived from a path is copied. The argument array and the copy share a single arena allocation.
+class expanded_arguments
 {
-    auto buff_size = count + 1;
-    auto buffer = new dnx::char_t[buff_size];
-#if defined(_WIN32)
-    wcsncpy_s(buffer, buff_size, value, count);
-#else
-    strncpy(buffer, value, count);
-    buffer[count] = '\0';
-#endif
-    return buffer;
-}
+public:
+    expanded_arguments(dnx::arena& arena, size_t capacity)
+        : m_arena(arena), m_args(arena.allocate<dnx::char_t*>(capacity)), m_count(0)
+    {}
 
-const dnx::char_t* allocate_and_copy(const dnx::char_t* value)
-{
-    return allocate_and_copy(value, x_strlen(value));
-}
+    void push_back(const dnx::char_t* value)
+    {
+        m_args[m_count++] = const_cast<dnx::char_t*>(value);
+    }
 
-void AppendAppbaseFromFile(const dnx::char_t* path, std::vector<const dnx::char_t*>& expanded_args)
+    void push_back_copy(const dnx::char_t* value, size_t count)
+    {
+        push_back(m_arena.copy(value, count));
+    }
+
+    size_t size() const
+    {
+        return m_count;
+    }
+
+    dnx::char_t** data() const
+    {
+        return m_args;
+    }
+
+private:
+    dnx::arena& m_arena;
+    dnx::char_t** m_args;
+    size_t m_count;
+};
+
+void AppendAppbaseFromFile(const dnx::char_t* path, expanded_arguments& expanded_args)
 {
     auto split_idx = split_path(path);
 
-    expanded_args.push_back(allocate_and_copy(_X("--appbase")));
+    expanded_args.push_back(_X("--appbase"));
 
     if (split_idx < 0)
     {
-        expanded_args.push_back(allocate_and_copy(_X(".")));
+        expanded_args.push_back(_X("."));
     }
     else
     {
-        expanded_args.push_back(allocate_and_copy(path, split_idx + 1));
+        expanded_args.push_back_copy(path, split_idx + 1);
     }
 }
 
-void ExpandProject(const dnx::char_t* project_path, std::vector<const dnx::char_t*>& expanded_args)
+void ExpandProject(const dnx::char_t* project_path, expanded_arguments& expanded_args)
 {
     auto split_idx = split_path(project_path);
 
@@ -77,16 +95,16 @@ void ExpandProject(const dnx::char_t* project_path, std::vector<const dnx::char_
     {
         // "dnx /path/project.json run" --> "dnx --appbase /path/ Microsoft.Dnx.ApplicationHost run"
         AppendAppbaseFromFile(project_path, expanded_args);
-        expanded_args.push_back(allocate_and_copy(_X("Microsoft.Dnx.ApplicationHost")));
+        expanded_args.push_back(_X("Microsoft.Dnx.ApplicationHost"));
         return;
     }
 
-    expanded_args.push_back(allocate_and_copy(_X("--appbase")));
-    expanded_args.push_back(allocate_and_copy(project_path));
-    expanded_args.push_back(allocate_and_copy(_X("Microsoft.Dnx.ApplicationHost")));
+    expanded_args.push_back(_X("--appbase"));
+    expanded_args.push_back(project_path);
+    expanded_args.push_back(_X("Microsoft.Dnx.ApplicationHost"));
 }
 
-void ExpandNonHostArgument(const dnx::char_t* value, std::vector<const dnx::char_t*>& expanded_args)
+void ExpandNonHostArgument(const dnx::char_t* value, expanded_arguments& expanded_args)
 {
     if (string_ends_with_ignore_case(value, _X(".dll")) || string_ends_with_ignore_case(value, _X(".exe")))
     {
@@ -94,85 +112,105 @@ void ExpandNonHostArgument(const dnx::char_t* value, std::vector<const dnx::char
         // "dnx /path/App.exe arg1" --> "dnx --appbase /path/ /path/App.exe arg1"
         // "dnx App.exe arg1" --> "dnx --appbase . App.exe arg1"
         AppendAppbaseFromFile(value, expanded_args);
-        expanded_args.push_back(allocate_and_copy(value));
+        expanded_args.push_back(value);
         return;
     }
 
     // "dnx run" --> "dnx --appbase . Microsoft.Dnx.ApplicationHost run"
-    expanded_args.push_back(allocate_and_copy(_X("--appbase")));
-    expanded_args.push_back(allocate_and_copy(_X(".")));
-    expanded_args.push_back(allocate_and_copy(_X("Microsoft.Dnx.ApplicationHost")));
-    expanded_args.push_back(allocate_and_copy(value));
+    expanded_args.push_back(_X("--appbase"));
+    expanded_args.push_back(_X("."));
+    expanded_args.push_back(_X("Microsoft.Dnx.ApplicationHost"));
+    expanded_args.push_back(value);
 }
 
-bool ExpandCommandLineArguments(int nArgc, dnx::char_t** ppszArgv, size_t& nExpandedArgc, dnx::char_t**& ppszExpandedArgv)
+// options - the parsed bootstrapper options of ppszArgv. If the arguments are expanded options.appbase is updated
+// to point to the implicit application base in ppszExpandedArgv; the indices are not updated.
+bool ExpandCommandLineArguments(int nArgc, dnx::char_t** ppszArgv, dnx::utils::bootstrapper_options& options,
+    size_t& nExpandedArgc, dnx::char_t**& ppszExpandedArgv)
 {
     // --appbase was found expansion not needed
-    if (dnx::utils::find_bootstrapper_option_index(nArgc, ppszArgv, _X("--appbase")) >= 0)
+    if (options.appbase_index >= 0)
     {
         return false;
     }
 
     // no non-bootstrapper option found expansion is not needed
-    auto param_idx = dnx::utils::find_first_non_bootstrapper_param_index(nArgc, ppszArgv);
+    auto param_idx = options.first_non_bootstrapper_param_index;
     if (param_idx < 0)
     {
         return false;
     }
 
-    bool arg_expanded = false;
-    std::vector<const dnx::char_t*> expanded_args_temp;
+    // The expansion adds at most 3 arguments and copies at most a prefix of the expanded argument
+    auto expanded_arg = options.project_index >= 0 ? ppszArgv[options.project_index + 1] : ppszArgv[param_idx];
+    dnx::arena arena{ dnx::arena::required_size<dnx::char_t*>(nArgc + 3) + dnx::arena::required_size<dnx::char_t>(x_strlen(expanded_arg) + 1) };
+    expanded_arguments expanded_args_temp{ arena, static_cast<size_t>(nArgc) + 3 };
+
+    // both ExpandProject and ExpandNonHostArgument start with '--appbase {path}'
+    size_t appbase_idx = 0;
     for (int source_idx = 0; source_idx < nArgc; source_idx++)
     {
-        if (!arg_expanded)
+        if (source_idx == options.project_index)
+        {
+            // Note that ++source_idx is safe here since if we had a trailing -p/--project we would have exited
+            // before entering the loop because we wouldn't have found any non host option
+            appbase_idx = expanded_args_temp.size() + 1;
+            ExpandProject(ppszArgv[++source_idx], expanded_args_temp);
+        }
+        else if (source_idx == param_idx && options.project_index < 0)
         {
-            if (dnx::utils::strings_equal_ignore_case(_X("-p"), ppszArgv[source_idx]) ||
-                dnx::utils::strings_equal_ignore_case(_X("--project"), ppszArgv[source_idx]))
-            {
-                // Note that ++source_idx is safe here since if we had a trailing -p/--project we would have exited
-                // before entering the loop because we wouldn't have found any non host option
-                ExpandProject(ppszArgv[++source_idx], expanded_args_temp);
-                arg_expanded = true;
-            }
-            else if (source_idx == param_idx)
-            {
-                ExpandNonHostArgument(ppszArgv[source_idx], expanded_args_temp);
-                arg_expanded = true;
-            }
-            else
-            {
-                expanded_args_temp.push_back(allocate_and_copy(ppszArgv[source_idx]));
-            }
+            appbase_idx = expanded_args_temp.size() + 1;
+            ExpandNonHostArgument(ppszArgv[source_idx], expanded_args_temp);
         }
         else
         {
-            expanded_args_temp.push_back(allocate_and_copy(ppszArgv[source_idx]));
+            expanded_args_temp.push_back(ppszArgv[source_idx]);
         }
     }
 
     nExpandedArgc = expanded_args_temp.size();
-    ppszExpandedArgv = new dnx::char_t*[nExpandedArgc];
+    ppszExpandedArgv = expanded_args_temp.data();
 
-    for (size_t i = 0; i < nExpandedArgc; i++)
-    {
-        ppszExpandedArgv[i] = const_cast<dnx::char_t*>(expanded_args_temp[i]);
-    }
+    // the argument array is the first allocation from the arena
+    arena.release();
+
+    options.appbase = ppszExpandedArgv[appbase_idx];
 
     return true;
 }
 
-void FreeExpandedCommandLineArguments(size_t nArgc, dnx::char_t** ppszArgv)
+bool ExpandCommandLineArguments(int nArgc, dnx::char_t** ppszArgv, size_t& nExpandedArgc, dnx::char_t**& ppszExpandedArgv)
 {
-    for (size_t i = 0; i < nArgc; ++i)
-    {
-        delete[] ppszArgv[i];
-    }
-    delete[] ppszArgv;
+    auto options = dnx::utils::parse_bootstrapper_options(nArgc, ppszArgv);
+    return ExpandCommandLineArguments(nArgc, ppszArgv, options, nExpandedArgc, ppszExpandedArgv);
 }
 
-bool GetApplicationBase(const dnx::xstring_t& currentDirectory, int argc, dnx::char_t* argv[], /*out*/ dnx::char_t* fullAppBasePath)
+void FreeExpandedCommandLineArguments(size_t /*nArgc*/, dnx::char_t** ppszArgv)
 {
-    const dnx::char_t* appBase = dnx::utils::get_option_value(argc, argv, _X("--appbase"));
+    dnx::arena::free_block(ppszArgv);
+}
+
+const dnx::char_t* GetHostModuleName()
+{
+    return
+#if defined(CORECLR_WIN)
+#if defined(ONECORE) || defined(ARM)
+        _X("dnx.onecore.coreclr.dll");
+#else
+        _X("dnx.win32.coreclr.dll");
+#endif
+#elif defined(CORECLR_DARWIN)
+        _X("dnx.coreclr.dylib");
+#elif defined(CORECLR_LINUX)
+        _X("dnx.coreclr.so");
+#else
+        _X("dnx.clr.dll");
+#endif
+}
+
+bool GetApplicationBase(const dnx::xstring_t& currentDirectory, const dnx::utils::bootstrapper_options& options, /*out*/ dnx::char_t* fullAppBasePath)
+{
+    const dnx::char_t* appBase = options.appbase;
     if (!appBase)
     {
         appBase = currentDirectory.c_str();
@@ -182,7 +220,7 @@ bool GetApplicationBase(const dnx::xstring_t& currentDirectory, int argc, dnx::c
     return GetFullPath(appBase, fullAppBasePath) != 0;
 }
 
-int CallApplicationProcessMain(int argc, dnx::char_t* argv[], dnx::trace_writer& trace_writer)
+int CallApplicationProcessMain(int argc, dnx::char_t* argv[], const dnx::utils::bootstrapper_options& options, dnx::trace_writer& trace_writer)
 {
     const auto currentDirectory = GetNativeBootstrapperDirectory();
 
@@ -190,39 +228,38 @@ int CallApplicationProcessMain(int argc, dnx::char_t* argv[], dnx::trace_writer&
     data.argc = argc;
     data.argv = const_cast<const dnx::char_t**>(argv);
     data.runtimeDirectory = currentDirectory.c_str();
+    data.perfMap = options.perf_map;
+    data.cpus = options.cpus;
+    data.numaNode = options.numa_node;
+    data.packagesDirectory = options.packages;
 
     dnx::char_t appBaseBuffer[MAX_PATH];
 
-    if (!GetApplicationBase(currentDirectory, argc, argv, appBaseBuffer))
+    dnx::phase_timer appbase_timer{ trace_writer, "GetApplicationBase" };
+    auto hasApplicationBase = GetApplicationBase(currentDirectory, options, appBaseBuffer);
+    appbase_timer.stop();
+
+    if (!hasApplicationBase)
     {
         return 1;
     }
 
     data.applicationBase = appBaseBuffer;
 
+    DNX_PROBE2(host__start, data.runtimeDirectory, data.applicationBase);
+
+    int exitCode;
     try
     {
-        const dnx::char_t* hostModuleName =
-#if defined(CORECLR_WIN)
-#if defined(ONECORE) || defined(ARM)
-            _X("dnx.onecore.coreclr.dll");
-#else
-            _X("dnx.win32.coreclr.dll");
-#endif
-#elif defined(CORECLR_DARWIN)
-            _X("dnx.coreclr.dylib");
-#elif defined(CORECLR_LINUX)
-            _X("dnx.coreclr.so");
-#else
-            _X("dnx.clr.dll");
-#endif
-
         // Note: need to keep as ASCII as GetProcAddress function takes ASCII params
-        return CallApplicationMain(hostModuleName, "CallApplicationMain", &data, trace_writer);
+        exitCode = CallApplicationMain(GetHostModuleName(), "CallApplicationMain", &data, trace_writer);
     }
     catch (const std::exception& ex)
     {
         xout << dnx::utils::to_xstring_t(ex.what()) << std::endl;
-        return 1;
+        exitCode = 1;
     }
+
+    DNX_PROBE1(host__exit, exitCode);
+    return exitCode;
 }
\ No newline at end of file
@@ -5,9 +5,9 @@
 #include "pal.h"
 #include "utils.h"
 
-int CallApplicationProcessMain(int argc, dnx::char_t* argv[], dnx::trace_writer& trace_writer);
+int CallApplicationProcessMain(int argc, dnx::char_t* argv[], const dnx::utils::bootstrapper_options& options, dnx::trace_writer& trace_writer);
 void FreeExpandedCommandLineArguments(size_t argc, dnx::char_t** ppszArgv);
-bool ExpandCommandLineArguments(int argc, dnx::char_t** ppszArgv, size_t& expanded_argc, dnx::char_t**& ppszExpandedArgv);
+bool ExpandCommandLineArguments(int argc, dnx::char_t** ppszArgv, dnx::utils::bootstrapper_options& options, size_t& expanded_argc, dnx::char_t**& ppszExpandedArgv);
 
 #if defined(ARM)
 int wmain(int argc, wchar_t* argv[])
@@ -17,20 +17,29 @@ int main(int argc, char* argv[])
 extern "C" int __stdcall DnxMain(int argc, wchar_t* argv[])
 #endif
 {
+    // The bootstrapper options are parsed once and reused by all the steps below
+    auto options = dnx::utils::parse_bootstrapper_options(argc - 1, &(argv[1]));
+
     // Check for the debug flag before doing anything else
-    dnx::utils::wait_for_debugger(argc - 1, const_cast<const dnx::char_t**>(&(argv[1])), _X("--bootstrapper-debug"));
+    if (options.bootstrapper_debug)
+    {
+        dnx::utils::wait_for_debugger();
+    }
+
+    auto trace_writer = dnx::trace_writer{ IsTracingEnabled(), GetTimingsFilePath() };
 
     size_t nExpandedArgc = 0;
     dnx::char_t** ppszExpandedArgv = nullptr;
-    auto expanded = ExpandCommandLineArguments(argc - 1, &(argv[1]), nExpandedArgc, ppszExpandedArgv);
+    dnx::phase_timer expand_timer{ trace_writer, "ExpandCommandLineArguments" };
+    auto expanded = ExpandCommandLineArguments(argc - 1, &(argv[1]), options, nExpandedArgc, ppszExpandedArgv);
+    expand_timer.stop();
 
-    auto trace_writer = dnx::trace_writer{ IsTracingEnabled() };
     if (!expanded)
     {
-        return CallApplicationProcessMain(argc - 1, &argv[1], trace_writer);
+        return CallApplicationProcessMain(argc - 1, &argv[1], options, trace_writer);
     }
 
-    auto exitCode = CallApplicationProcessMain(static_cast<int>(nExpandedArgc), ppszExpandedArgv, trace_writer);
+    auto exitCode = CallApplicationProcessMain(static_cast<int>(nExpandedArgc), ppszExpandedArgv, options, trace_writer);
     FreeExpandedCommandLineArguments(nExpandedArgc, ppszExpandedArgv);
     return exitCode;
 }
@@ -6,17 +6,30 @@
 #include <assert.h>
 #include <libproc.h>
 
-std::string GetNativeBootstrapperDirectory()
+namespace
 {
-    char buffer[PROC_PIDPATHINFO_MAXSIZE];
-    ssize_t ret = proc_pidpath(getpid(), buffer, PROC_PIDPATHINFO_MAXSIZE);
+    std::string ResolveNativeBootstrapperPath()
+    {
+        char buffer[PROC_PIDPATHINFO_MAXSIZE];
+        ssize_t ret = proc_pidpath(getpid(), buffer, PROC_PIDPATHINFO_MAXSIZE);
+
+        assert(ret != -1);
 
-    assert(ret != -1);
+        return std::string(buffer, ret > 0 ? ret : 0);
+    }
+}
 
-    for (; ret > 0 && buffer[ret] != '/'; ret--)
-        ;
+// The path is resolved once - it is used by several steps of the bootstrapper and by the host module
+const char* GetNativeBootstrapperPath()
+{
+    static const std::string path = ResolveNativeBootstrapperPath();
+    return path.c_str();
+}
 
-    buffer[ret] = '\0';
+std::string GetNativeBootstrapperDirectory()
+{
+    std::string path = GetNativeBootstrapperPath();
+    auto separator = path.find_last_of('/');
 
-    return std::string(buffer);
-}
\ No newline at end of file
+    return separator == std::string::npos ? std::string() : path.substr(0, separator);
+}
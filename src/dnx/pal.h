@@ -9,5 +9,6 @@
 
 dnx::xstring_t GetNativeBootstrapperDirectory();
 bool IsTracingEnabled();
+dnx::xstring_t GetTimingsFilePath();
 bool GetFullPath(const dnx::char_t* szPath, dnx::char_t*  szFullPath);
 int CallApplicationMain(const dnx::char_t* moduleName, const char* functionName, CALL_APPLICATION_MAIN_DATA* data, dnx::trace_writer& trace_writer);
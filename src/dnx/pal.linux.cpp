@@ -6,20 +6,33 @@
 #include <assert.h>
 #include <dlfcn.h>
 
-std::string GetNativeBootstrapperDirectory()
+namespace
 {
-    char buffer[PATH_MAX + 1];
-    ssize_t ret = readlink("/proc/self/exe", buffer, PATH_MAX);
+    std::string ResolveNativeBootstrapperPath()
+    {
+        char buffer[PATH_MAX + 1];
+        ssize_t ret = readlink("/proc/self/exe", buffer, PATH_MAX);
+
+        assert(ret != -1);
 
-    assert(ret != -1);
+        // readlink does not null terminate the path
+        buffer[ret] = '\0';
 
-    // readlink does not null terminate the path
-    buffer[ret] = '\0';
+        return std::string(buffer);
+    }
+}
 
-    for (; ret > 0 && buffer[ret] != '/'; ret--)
-        ;
+// /proc/self/exe is resolved once - the path is used by several steps of the bootstrapper and by the host module
+const char* GetNativeBootstrapperPath()
+{
+    static const std::string path = ResolveNativeBootstrapperPath();
+    return path.c_str();
+}
 
-    buffer[ret] = '\0';
+std::string GetNativeBootstrapperDirectory()
+{
+    std::string path = GetNativeBootstrapperPath();
+    auto separator = path.find_last_of('/');
 
-    return std::string(buffer);
-}
\ No newline at end of file
+    return separator == std::string::npos ? std::string() : path.substr(0, separator);
+}
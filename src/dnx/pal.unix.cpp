@@ -8,9 +8,11 @@
 #include <assert.h>
 #include <dlfcn.h>
 #include "app_main.h"
+#include "probes.h"
 #include "trace_writer.h"
 
 std::string GetNativeBootstrapperDirectory();
+const char* GetNativeBootstrapperPath();
 
 bool IsTracingEnabled()
 {
@@ -18,6 +20,12 @@ bool IsTracingEnabled()
     return dnxTraceEnv != NULL && (strcmp(dnxTraceEnv, "1") == 0);
 }
 
+std::string GetTimingsFilePath()
+{
+    char* dnxTraceTimingsEnv = getenv("DNX_TRACE_TIMINGS");
+    return dnxTraceTimingsEnv != NULL ? std::string(dnxTraceTimingsEnv) : std::string();
+}
+
 bool GetFullPath(const char* szPath, char* szNormalizedPath)
 {
     if (realpath(szPath, szNormalizedPath) == nullptr)
@@ -32,11 +40,15 @@ bool GetFullPath(const char* szPath, char* szNormalizedPath)
 int CallApplicationMain(const char* moduleName, const char* functionName, CALL_APPLICATION_MAIN_DATA* data, dnx::trace_writer& trace_writer)
 {
     auto localPath = GetNativeBootstrapperDirectory().append("/").append(moduleName);
+    data->bootstrapperPath = GetNativeBootstrapperPath();
 
     void* host = nullptr;
     try
     {
+        dnx::phase_timer dlopen_timer{ trace_writer, "dlopen" };
         host = dlopen(localPath.c_str(), RTLD_NOW | RTLD_GLOBAL);
+        dlopen_timer.stop();
+        DNX_PROBE2(module__load, localPath.c_str(), host != nullptr);
         if (!host)
         {
             std::ostringstream oss;
@@ -58,6 +70,7 @@ int CallApplicationMain(const char* moduleName, const char* functionName, CALL_A
         trace_writer.write(std::string("Found export: ").append(functionName), true);
 
         auto result = pfnCallApplicationMain(data);
+        DNX_PROBE2(module__return, localPath.c_str(), result);
         dlclose(host);
         return result == 0 ? data->exitcode : result;
     }
@@ -70,4 +83,4 @@ int CallApplicationMain(const char* moduleName, const char* functionName, CALL_A
 
         throw;
     }
-}
\ No newline at end of file
+}
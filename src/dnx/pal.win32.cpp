@@ -27,6 +27,13 @@ bool IsTracingEnabled()
     return GetEnvironmentVariable(L"DNX_TRACE", buff, 2) == 1 && buff[0] == L'1';
 }
 
+std::wstring GetTimingsFilePath()
+{
+    wchar_t buff[MAX_PATH];
+    auto length = GetEnvironmentVariable(L"DNX_TRACE_TIMINGS", buff, MAX_PATH);
+    return length > 0 && length < MAX_PATH ? std::wstring(buff) : std::wstring{};
+}
+
 bool GetFullPath(LPCTSTR szPath, LPTSTR pszNormalizedPath)
 {
     DWORD dwFullAppBase = GetFullPathName(szPath, MAX_PATH, pszNormalizedPath, nullptr);
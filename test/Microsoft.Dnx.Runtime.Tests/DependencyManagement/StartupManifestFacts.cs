@@ -0,0 +1,148 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Runtime.Versioning;
+using System.Text;
+using Microsoft.Dnx.CommonTestUtils;
+using Microsoft.Dnx.Runtime.Servicing;
+using Xunit;
+
+namespace Microsoft.Dnx.Runtime.Tests
+{
+    public class StartupManifestFacts
+    {
+        private static readonly FrameworkName DnxCore50 = new FrameworkName("DNXCore", new Version(5, 0));
+        private static readonly string PackagesDirectory = Path.GetFullPath("packages");
+
+        [Fact]
+        public void ManifestRoundTrips()
+        {
+            using (var projectDirectory = CreateProjectDirectory())
+            {
+                CreateManifest().Write(projectDirectory);
+
+                var manifest = StartupManifest.Read(projectDirectory);
+
+                Assert.NotNull(manifest);
+                Assert.Equal(DnxCore50, manifest.TargetFramework);
+                Assert.Equal("Linux", manifest.OperatingSystem);
+                Assert.Equal("ubuntu 14.04", manifest.OperatingSystemVersion);
+                Assert.Equal("x64", manifest.Architecture);
+                Assert.Equal(PackagesDirectory, manifest.PackagesDirectory);
+                Assert.Equal(new[] { "ubuntu.14.04-x64" }, manifest.RuntimeIdentifiers);
+                Assert.Equal(new[] { "/packages/native" }, manifest.NativeLibraryDirectories);
+
+                var assemblies = manifest.GetAssemblyPaths();
+                Assert.Equal(2, assemblies.Count);
+                Assert.Equal("/packages/Foo/lib/Foo.dll", assemblies.Single(a => string.IsNullOrEmpty(a.Key.CultureName)).Value);
+                Assert.Equal("/packages/Foo/lib/fr/Foo.resources.dll", assemblies.Single(a => a.Key.CultureName == "fr").Value);
+
+                var assembly = manifest.Assemblies.First();
+                Assert.Equal("Foo", assembly.PackageId);
+                Assert.Equal("1.0.0", assembly.PackageVersion);
+                Assert.Equal("lib/Foo.dll", assembly.AssetPath);
+            }
+        }
+
+        [Fact]
+        public void ServicingIndexIsAppliedToAssemblyPaths()
+        {
+            var index = new ServicingIndex();
+            using (var indexStream = new MemoryStream(Encoding.UTF8.GetBytes(
+                "nupkg|Foo|1.0.0|lib/Foo.dll=patches/Foo/1.0.0-patch/lib/Foo.dll")))
+            {
+                index.Initialize("/servicing", indexStream);
+            }
+
+            var assemblies = CreateManifest().GetAssemblyPaths(index.TryGetReplacement);
+
+            Assert.Equal(Path.Combine("/servicing", "patches/Foo/1.0.0-patch/lib/Foo.dll"), assemblies.Single(a => string.IsNullOrEmpty(a.Key.CultureName)).Value);
+            Assert.Equal("/packages/Foo/lib/fr/Foo.resources.dll", assemblies.Single(a => a.Key.CultureName == "fr").Value);
+        }
+
+        [Fact]
+        public void ManifestIsStaleWhenLockFileChanges()
+        {
+            using (var projectDirectory = CreateProjectDirectory())
+            {
+                CreateManifest().Write(projectDirectory);
+
+                File.WriteAllText(Path.Combine(projectDirectory, LockFileReader.LockFileName), "{ \"locked\": true }");
+
+                Assert.Null(StartupManifest.Read(projectDirectory));
+            }
+        }
+
+        [Fact]
+        public void ManifestIsOnlyValidForTheTargetItWasResolvedFor()
+        {
+            var manifest = CreateManifest();
+
+            Assert.True(manifest.IsValidFor(DnxCore50, new[] { "ubuntu.14.04-x64" }, PackagesDirectory));
+            Assert.True(manifest.IsValidFor(DnxCore50, new[] { "ubuntu.14.04-x64" }, PackagesDirectory + Path.DirectorySeparatorChar));
+            Assert.False(manifest.IsValidFor(new FrameworkName("DNX", new Version(4, 5, 1)), new[] { "ubuntu.14.04-x64" }, PackagesDirectory));
+            Assert.False(manifest.IsValidFor(DnxCore50, new[] { "win7-x64" }, PackagesDirectory));
+            Assert.False(manifest.IsValidFor(DnxCore50, new[] { "ubuntu.14.04-x64" }, Path.GetFullPath("other-packages")));
+        }
+
+        [Theory]
+        [InlineData("Lib", null, true)]
+        [InlineData("lib", null, true)]
+        [InlineData("Lib.resources", "fr", true)]
+        [InlineData("Lib.resources", null, false)]
+        [InlineData("Library", null, false)]
+        public void PackageAssembliesNamedLikeProjectReferencesAreLeftOut(string name, string culture, bool isProvidedByProject)
+        {
+            var projectNames = new HashSet<string>(new[] { "App", "Lib" }, StringComparer.OrdinalIgnoreCase);
+
+            Assert.Equal(isProvidedByProject, StartupManifest.IsProvidedByProject(
+                PackageDependencyProvider.CreateAssemblyName(name, culture),
+                projectNames));
+        }
+
+        [Fact]
+        public void MalformedManifestIsIgnored()
+        {
+            using (var projectDirectory = CreateProjectDirectory())
+            {
+                CreateManifest().Write(projectDirectory);
+
+                var manifestPath = Path.Combine(projectDirectory, StartupManifest.StartupManifestFileName);
+                var bytes = File.ReadAllBytes(manifestPath);
+                File.WriteAllBytes(manifestPath, bytes.Take(bytes.Length - 4).ToArray());
+
+                Assert.Null(StartupManifest.Read(projectDirectory));
+            }
+        }
+
+        private static DisposableDir CreateProjectDirectory()
+        {
+            var projectDirectory = new DisposableDir();
+            File.WriteAllText(Path.Combine(projectDirectory, Project.ProjectFileName), "{ }");
+            File.WriteAllText(Path.Combine(projectDirectory, LockFileReader.LockFileName), "{ \"locked\": false }");
+            return projectDirectory;
+        }
+
+        private static StartupManifest CreateManifest()
+        {
+            var manifest = new StartupManifest
+            {
+                TargetFramework = DnxCore50,
+                OperatingSystem = "Linux",
+                OperatingSystemVersion = "ubuntu 14.04",
+                Architecture = "x64",
+                PackagesDirectory = PackagesDirectory
+            };
+
+            manifest.RuntimeIdentifiers.Add("ubuntu.14.04-x64");
+            manifest.Assemblies.Add(new StartupManifestAssembly("Foo", null, "Foo", "1.0.0", "lib/Foo.dll", "/packages/Foo/lib/Foo.dll"));
+            manifest.Assemblies.Add(new StartupManifestAssembly("Foo.resources", "fr", "Foo", "1.0.0", "lib/fr/Foo.resources.dll", "/packages/Foo/lib/fr/Foo.resources.dll"));
+            manifest.NativeLibraryDirectories.Add("/packages/native");
+            return manifest;
+        }
+    }
+}
@@ -0,0 +1,212 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using Microsoft.Dnx.CommonTestUtils;
+using Microsoft.Dnx.Host;
+using Microsoft.Extensions.PlatformAbstractions;
+using Xunit;
+
+namespace Microsoft.Dnx.Runtime.Tests.Host
+{
+    public class PathBasedAssemblyLoaderFacts
+    {
+        [Fact]
+        public void LoadsAssemblyWithExactCaseOnLinux()
+        {
+            using (var searchPath = CreateSearchPath("Foo.dll"))
+            {
+                var loadContext = new RecordingLoadContext();
+                var loader = CreateLoader(loadContext, RuntimeOperatingSystems.Linux, searchPath);
+
+                Assert.Null(loader.Load(new AssemblyName("foo")));
+                Assert.Empty(loadContext.LoadedPaths);
+
+                Assert.NotNull(loader.Load(new AssemblyName("Foo")));
+                Assert.Equal(new[] { Path.Combine(searchPath, "Foo.dll") }, loadContext.LoadedPaths);
+            }
+        }
+
+        [Theory]
+        [InlineData("Windows")]
+        [InlineData("Darwin")]
+        public void LoadsAssemblyIgnoringCaseOnWindowsAndDarwin(string operatingSystem)
+        {
+            using (var searchPath = CreateSearchPath("Foo.dll"))
+            {
+                var loadContext = new RecordingLoadContext();
+                var loader = CreateLoader(loadContext, operatingSystem, searchPath);
+
+                Assert.NotNull(loader.Load(new AssemblyName("FOO")));
+                Assert.Equal(new[] { Path.Combine(searchPath, "Foo.dll") }, loadContext.LoadedPaths);
+            }
+        }
+
+        [Fact]
+        public void PrefersDllOverExeAndEarlierSearchPaths()
+        {
+            using (var firstSearchPath = CreateSearchPath("Foo.exe"))
+            using (var secondSearchPath = CreateSearchPath("Foo.dll", "Bar.dll"))
+            {
+                var loadContext = new RecordingLoadContext();
+                var loader = CreateLoader(loadContext, RuntimeOperatingSystems.Linux, firstSearchPath, secondSearchPath);
+
+                Assert.NotNull(loader.Load(new AssemblyName("Foo")));
+                Assert.NotNull(loader.Load(new AssemblyName("Bar")));
+                Assert.Equal(new[]
+                {
+                    Path.Combine(firstSearchPath, "Foo.exe"),
+                    Path.Combine(secondSearchPath, "Bar.dll")
+                }, loadContext.LoadedPaths);
+            }
+        }
+
+        [Fact]
+        public void LoadsSatelliteAssemblyFromCultureSubdirectory()
+        {
+            using (var searchPath = CreateSearchPath("Foo.dll", Path.Combine("fr-FR", "Foo.resources.dll")))
+            {
+                var loadContext = new RecordingLoadContext();
+                var loader = CreateLoader(loadContext, RuntimeOperatingSystems.Windows, searchPath);
+
+                Assert.NotNull(loader.Load(new AssemblyName("Foo.resources, Culture=fr-FR")));
+                Assert.Null(loader.Load(new AssemblyName("Foo.resources, Culture=de-DE")));
+                Assert.Null(loader.Load(new AssemblyName("Foo, Culture=de-DE")));
+
+                // the culture directory is matched with the case rules of the file system
+                Assert.NotNull(loader.Load(new AssemblyName("Foo.resources, Culture=FR-fr")));
+
+                Assert.Equal(new[]
+                {
+                    Path.Combine(searchPath, "fr-FR", "Foo.resources.dll"),
+                    Path.Combine(searchPath, "fr-FR", "Foo.resources.dll")
+                }, loadContext.LoadedPaths);
+            }
+        }
+
+        [Fact]
+        public void FindsAssemblyAddedAfterLookupMissed()
+        {
+            using (var searchPath = CreateSearchPath("Foo.dll"))
+            {
+                var loadContext = new RecordingLoadContext();
+                var loader = CreateLoader(loadContext, RuntimeOperatingSystems.Linux, searchPath);
+
+                Assert.Null(loader.Load(new AssemblyName("Bar")));
+
+                // Added within the timestamp resolution of the file system - the last write time of the directory
+                // does not change
+                var lastWriteTime = Directory.GetLastWriteTimeUtc(searchPath);
+                File.WriteAllText(Path.Combine(searchPath, "Bar.dll"), string.Empty);
+                Directory.SetLastWriteTimeUtc(searchPath, lastWriteTime);
+
+                Assert.NotNull(loader.Load(new AssemblyName("Bar")));
+                Assert.Equal(new[] { Path.Combine(searchPath, "Bar.dll") }, loadContext.LoadedPaths);
+            }
+        }
+
+        [Fact]
+        public void IgnoresMissingSearchPaths()
+        {
+            using (var searchPath = CreateSearchPath("Foo.dll"))
+            {
+                var loadContext = new RecordingLoadContext();
+                var loader = CreateLoader(loadContext, RuntimeOperatingSystems.Linux, Path.Combine(searchPath, "missing"), searchPath);
+
+                Assert.NotNull(loader.Load(new AssemblyName("Foo")));
+                Assert.Equal(new[] { Path.Combine(searchPath, "Foo.dll") }, loadContext.LoadedPaths);
+            }
+        }
+
+        private static DisposableDir CreateSearchPath(params string[] files)
+        {
+            var searchPath = new DisposableDir();
+            foreach (var file in files)
+            {
+                var filePath = Path.Combine(searchPath, file);
+                Directory.CreateDirectory(Path.GetDirectoryName(filePath));
+                File.WriteAllText(filePath, string.Empty);
+            }
+
+            return searchPath;
+        }
+
+        private static PathBasedAssemblyLoader CreateLoader(RecordingLoadContext loadContext, string operatingSystem, params string[] searchPaths)
+        {
+            return new PathBasedAssemblyLoader(
+                new LoadContextAccessor(loadContext),
+                searchPaths,
+                new FakeRuntimeEnvironment { OperatingSystem = operatingSystem });
+        }
+
+        private class RecordingLoadContext : IAssemblyLoadContext
+        {
+            public List<string> LoadedPaths { get; } = new List<string>();
+
+            public Assembly Load(AssemblyName assemblyName)
+            {
+                throw new NotImplementedException();
+            }
+
+            public Assembly LoadFile(string path)
+            {
+                LoadedPaths.Add(path);
+                return typeof(RecordingLoadContext).GetTypeInfo().Assembly;
+            }
+
+            public Assembly LoadStream(Stream assemblyStream, Stream assemblySymbols)
+            {
+                throw new NotImplementedException();
+            }
+
+            public IntPtr LoadUnmanagedLibrary(string name)
+            {
+                throw new NotImplementedException();
+            }
+
+            public IntPtr LoadUnmanagedLibraryFromPath(string path)
+            {
+                throw new NotImplementedException();
+            }
+
+            public void Dispose()
+            {
+            }
+        }
+
+        private class LoadContextAccessor : IAssemblyLoadContextAccessor
+        {
+            public LoadContextAccessor(IAssemblyLoadContext loadContext)
+            {
+                Default = loadContext;
+            }
+
+            public IAssemblyLoadContext Default { get; }
+
+            public IAssemblyLoadContext GetLoadContext(Assembly assembly)
+            {
+                return Default;
+            }
+        }
+
+        private class FakeRuntimeEnvironment : IRuntimeEnvironment
+        {
+            public string OperatingSystem { get; set; }
+
+            public Platform OperatingSystemPlatform { get; set; }
+
+            public string OperatingSystemVersion { get; set; }
+
+            public string RuntimeArchitecture { get; set; }
+
+            public string RuntimePath { get; set; }
+
+            public string RuntimeType { get; set; }
+
+            public string RuntimeVersion { get; set; }
+        }
+    }
+}
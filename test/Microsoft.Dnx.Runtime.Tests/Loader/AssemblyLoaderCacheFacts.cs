@@ -0,0 +1,149 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+using System.Reflection;
+using System.Threading;
+using System.Threading.Tasks;
+using Microsoft.Dnx.Runtime.Loader;
+using Xunit;
+
+namespace Microsoft.Dnx.Runtime.Tests.Loader
+{
+    public class AssemblyLoaderCacheFacts
+    {
+        private static readonly Assembly TestAssembly = typeof(AssemblyLoaderCacheFacts).GetTypeInfo().Assembly;
+
+        [Fact]
+        public void LoadsAssemblyOnce()
+        {
+            var cache = new AssemblyLoaderCache();
+            var loads = 0;
+
+            Assert.Same(TestAssembly, cache.GetOrAdd(new AssemblyName("Foo"), name => { loads++; return TestAssembly; }));
+            Assert.Same(TestAssembly, cache.GetOrAdd(new AssemblyName("Foo"), name => { loads++; return null; }));
+            Assert.Equal(1, loads);
+        }
+
+        [Fact]
+        public void RemembersNamesThatCouldNotBeLoaded()
+        {
+            var cache = new AssemblyLoaderCache();
+            var loads = 0;
+
+            Assert.Null(cache.GetOrAdd(new AssemblyName("Foo"), name => { loads++; return null; }));
+            Assert.Null(cache.GetOrAdd(new AssemblyName("Foo"), name => { loads++; return TestAssembly; }));
+            Assert.Equal(1, loads);
+
+            // Names differing in culture are different names
+            Assert.Same(TestAssembly, cache.GetOrAdd(new AssemblyName("Foo, Culture=fr-FR"), name => { loads++; return TestAssembly; }));
+            Assert.Equal(2, loads);
+        }
+
+        [Fact]
+        public void InvalidateForgetsNamesThatCouldNotBeLoaded()
+        {
+            var cache = new AssemblyLoaderCache();
+            var loads = 0;
+
+            cache.GetOrAdd(new AssemblyName("Foo"), name => { loads++; return TestAssembly; });
+            cache.GetOrAdd(new AssemblyName("Bar"), name => { loads++; return null; });
+
+            AssemblyLoaderCache.Invalidate();
+
+            Assert.Same(TestAssembly, cache.GetOrAdd(new AssemblyName("Foo"), name => { loads++; return null; }));
+            Assert.Same(TestAssembly, cache.GetOrAdd(new AssemblyName("Bar"), name => { loads++; return TestAssembly; }));
+            Assert.Equal(3, loads);
+        }
+
+        [Fact]
+        public void IgnoresNameThatCouldNotBeLoadedWhileCacheWasInvalidated()
+        {
+            var cache = new AssemblyLoaderCache();
+            var loads = 0;
+
+            cache.GetOrAdd(new AssemblyName("Foo"), name =>
+            {
+                loads++;
+                AssemblyLoaderCache.Invalidate();
+                return null;
+            });
+
+            Assert.Same(TestAssembly, cache.GetOrAdd(new AssemblyName("Foo"), name => { loads++; return TestAssembly; }));
+            Assert.Equal(2, loads);
+        }
+
+        [Fact]
+        public void StartsOverWhenTooManyNamesCouldNotBeLoaded()
+        {
+            var cache = new AssemblyLoaderCache();
+
+            for (var i = 0; i <= AssemblyLoaderCache.MaxMisses; i++)
+            {
+                cache.GetOrAdd(new AssemblyName("Foo" + i), name => null);
+            }
+
+            var loads = 0;
+            cache.GetOrAdd(new AssemblyName("Foo0"), name => { loads++; return null; });
+            Assert.Equal(1, loads);
+        }
+
+        [Fact]
+        public void LoadsNameAgainWhenLoadedReentrantly()
+        {
+            var cache = new AssemblyLoaderCache();
+            var loads = 0;
+
+            var assembly = cache.GetOrAdd(new AssemblyName("Foo"), name =>
+            {
+                loads++;
+
+                // e.g. a project asking for itself while it is compiled
+                Assert.Null(cache.GetOrAdd(new AssemblyName("Foo"), innerName => { loads++; return null; }));
+                Assert.Same(TestAssembly, cache.GetOrAdd(new AssemblyName("Bar"), innerName => { loads++; return TestAssembly; }));
+
+                return TestAssembly;
+            });
+
+            Assert.Same(TestAssembly, assembly);
+            Assert.Equal(3, loads);
+
+            // The assembly loaded by the outer load wins over the miss of the inner one
+            Assert.Same(TestAssembly, cache.GetOrAdd(new AssemblyName("Foo"), name => { loads++; return null; }));
+            Assert.Equal(3, loads);
+        }
+
+        [Fact]
+        public void LoadsNameOnceWhenLoadedConcurrently()
+        {
+            var cache = new AssemblyLoaderCache();
+            var loads = 0;
+
+            using (var loading = new ManualResetEventSlim())
+            using (var release = new ManualResetEventSlim())
+            {
+                var first = Task.Run(() => cache.GetOrAdd(new AssemblyName("Foo"), name =>
+                {
+                    Interlocked.Increment(ref loads);
+                    loading.Set();
+                    release.Wait();
+                    return TestAssembly;
+                }));
+
+                loading.Wait();
+                var second = Task.Run(() => cache.GetOrAdd(new AssemblyName("Foo"), name =>
+                {
+                    Interlocked.Increment(ref loads);
+                    return null;
+                }));
+
+                // The second load waits for the first one
+                Assert.False(second.Wait(100));
+                release.Set();
+
+                Assert.Same(TestAssembly, first.Result);
+                Assert.Same(TestAssembly, second.Result);
+                Assert.Equal(1, loads);
+            }
+        }
+    }
+}
@@ -0,0 +1,132 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+// Measures the wall time of an application with the normal teardown (DNX_FAST_EXIT=0) and with the fast exit
+// (DNX_FAST_EXIT=1) that skips coreclr_shutdown and the unloading of the host modules. The runs are interleaved
+// so that both see the same system conditions and the first run of each is a warm up that is not counted.
+//
+// usage: dnx.fastexit.benchmark <iterations> <command...>
+// e.g. dnx.fastexit.benchmark 20 dnx -p /src/app run
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    long long now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Runs the command with DNX_FAST_EXIT set to the given value and returns the wall time in nanoseconds
+    long long run(char** command, const char* fast_exit, int& exit_code)
+    {
+        auto start = now_ns();
+
+        auto pid = fork();
+        if (pid < 0)
+        {
+            perror("fork");
+            exit(1);
+        }
+
+        if (pid == 0)
+        {
+            setenv("DNX_FAST_EXIT", fast_exit, 1);
+            execvp(command[0], command);
+            perror(command[0]);
+            _exit(127);
+        }
+
+        int status;
+        if (waitpid(pid, &status, 0) < 0)
+        {
+            perror("waitpid");
+            exit(1);
+        }
+
+        auto elapsed = now_ns() - start;
+
+        if (!WIFEXITED(status))
+        {
+            fprintf(stderr, "The command terminated abnormally with status %d\n", status);
+            exit_code = -1;
+        }
+        else
+        {
+            exit_code = WEXITSTATUS(status);
+        }
+
+        return elapsed;
+    }
+
+    void report(const char* name, std::vector<long long> samples)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        long long total = 0;
+        for (auto ns : samples)
+        {
+            total += ns;
+        }
+
+        printf("%s\n", name);
+        printf("  mean:       %12.3f ms\n", total / 1e6 / samples.size());
+        printf("  min:        %12.3f ms\n", samples.front() / 1e6);
+        printf("  median:     %12.3f ms\n", samples[samples.size() / 2] / 1e6);
+        printf("  max:        %12.3f ms\n", samples.back() / 1e6);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <iterations> <command...>\n", argv[0]);
+        return 1;
+    }
+
+    auto iterations = atoi(argv[1]);
+    auto command = &argv[2];
+
+    if (iterations < 1)
+    {
+        fprintf(stderr, "The number of iterations must be greater than 0\n");
+        return 1;
+    }
+
+    std::vector<long long> teardown;
+    std::vector<long long> fast_exit;
+    auto mismatches = 0;
+
+    for (auto i = 0; i <= iterations; i++)
+    {
+        int teardown_exit_code, fast_exit_code;
+        auto teardown_ns = run(command, "0", teardown_exit_code);
+        auto fast_exit_ns = run(command, "1", fast_exit_code);
+
+        // the fast exit must not change what the application reports
+        if (teardown_exit_code != fast_exit_code)
+        {
+            fprintf(stderr, "The exit codes differ: %d (teardown) and %d (fast exit)\n", teardown_exit_code, fast_exit_code);
+            mismatches++;
+        }
+
+        if (i > 0)
+        {
+            teardown.push_back(teardown_ns);
+            fast_exit.push_back(fast_exit_ns);
+        }
+    }
+
+    report("DNX_FAST_EXIT=0", teardown);
+    report("DNX_FAST_EXIT=1", fast_exit);
+
+    return mismatches == 0 ? 0 : 1;
+}
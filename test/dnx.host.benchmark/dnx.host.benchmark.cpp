@@ -0,0 +1,137 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+// Measures the cost of running an application repeatedly through the hosting API (see dnx_host.h)
+//
+// usage: dnx.host.benchmark <runtime directory> <application base> <iterations> <arguments...>
+// e.g. dnx.host.benchmark ~/.dnx/runtimes/dnx-coreclr-linux-x64.1.0.0/bin /src/app 100 --appbase /src/app Microsoft.Dnx.ApplicationHost run
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <dlfcn.h>
+#include "dnx_host.h"
+
+namespace
+{
+    long long now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    template<typename T>
+    T get_export(void* module, const char* name)
+    {
+        auto export_address = reinterpret_cast<T>(dlsym(module, name));
+        if (!export_address)
+        {
+            fprintf(stderr, "Failed to find export '%s'\n", name);
+            exit(1);
+        }
+
+        return export_address;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 5)
+    {
+        fprintf(stderr, "usage: %s <runtime directory> <application base> <iterations> <arguments...>\n", argv[0]);
+        return 1;
+    }
+
+    auto runtime_directory = argv[1];
+    auto application_base = argv[2];
+    auto iterations = atoi(argv[3]);
+    auto app_argc = argc - 4;
+    auto app_argv = const_cast<const char**>(&argv[4]);
+
+    if (iterations < 1)
+    {
+        fprintf(stderr, "The number of iterations must be greater than 0\n");
+        return 1;
+    }
+
+#if defined(__APPLE__)
+    auto module_path = std::string(runtime_directory).append("/dnx.coreclr.dylib");
+#else
+    auto module_path = std::string(runtime_directory).append("/dnx.coreclr.so");
+#endif
+
+    auto start = now_ns();
+    auto module = dlopen(module_path.c_str(), RTLD_NOW | RTLD_GLOBAL);
+    if (!module)
+    {
+        fprintf(stderr, "Failed to load '%s': %s\n", module_path.c_str(), dlerror());
+        return 1;
+    }
+
+    auto host_create = get_export<dnx_host_create_fn>(module, "dnx_host_create");
+    auto host_execute = get_export<dnx_host_execute_fn>(module, "dnx_host_execute");
+    auto host_destroy = get_export<dnx_host_destroy_fn>(module, "dnx_host_destroy");
+    auto load_ns = now_ns() - start;
+
+    start = now_ns();
+    dnx_host* host;
+    if (host_create(runtime_directory, application_base, &host) != 0)
+    {
+        fprintf(stderr, "Failed to create the host\n");
+        return 1;
+    }
+
+    auto create_ns = now_ns() - start + load_ns;
+
+    std::vector<long long> call_ns;
+    for (auto i = 0; i < iterations; i++)
+    {
+        int exit_code;
+        auto call_start = now_ns();
+        if (host_execute(host, app_argc, app_argv, &exit_code) != 0)
+        {
+            fprintf(stderr, "Failed to execute the application\n");
+            return 1;
+        }
+
+        call_ns.push_back(now_ns() - call_start);
+
+        if (exit_code != 0)
+        {
+            fprintf(stderr, "The application exited with %d in iteration %d\n", exit_code, i);
+        }
+    }
+
+    start = now_ns();
+    host_destroy(host);
+    auto destroy_ns = now_ns() - start;
+
+    printf("create:       %12.3f ms\n", create_ns / 1e6);
+    printf("first call:   %12.3f ms\n", call_ns[0] / 1e6);
+
+    if (call_ns.size() > 1)
+    {
+        // the first call includes loading and jitting the application and is reported separately
+        std::vector<long long> warm(call_ns.begin() + 1, call_ns.end());
+        std::sort(warm.begin(), warm.end());
+
+        long long total = 0;
+        for (auto ns : warm)
+        {
+            total += ns;
+        }
+
+        printf("warm calls:   %12zu\n", warm.size());
+        printf("mean:         %12.3f ms\n", total / 1e6 / warm.size());
+        printf("min:          %12.3f ms\n", warm.front() / 1e6);
+        printf("median:       %12.3f ms\n", warm[warm.size() / 2] / 1e6);
+        printf("p95:          %12.3f ms\n", warm[warm.size() * 95 / 100] / 1e6);
+    }
+
+    printf("destroy:      %12.3f ms\n", destroy_ns / 1e6);
+
+    return 0;
+}
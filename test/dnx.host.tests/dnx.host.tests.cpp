@@ -0,0 +1,169 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+// Tests the hosting API (see dnx_host.h) with fake_coreclr.cpp standing in for libcoreclr. A host can be created
+// only once per process so the checks depend on each other and run in order.
+//
+// usage: dnx.host.tests <runtime directory>
+// The runtime directory contains dnx.coreclr.so and fake_coreclr.cpp built as libcoreclr.so. The trusted platform
+// assemblies are created as empty files.
+
+#include <fstream>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <dlfcn.h>
+#include <unistd.h>
+#include "dnx_host.h"
+#include "tpa.h"
+#include "utils.h"
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool condition, const char* description)
+    {
+        printf("[%s] %s\n", condition ? "PASSED" : "FAILED", description);
+        if (!condition)
+        {
+            failures++;
+        }
+    }
+
+    template<typename T>
+    T get_export(void* module, const char* name)
+    {
+        auto export_address = reinterpret_cast<T>(dlsym(module, name));
+        if (!export_address)
+        {
+            fprintf(stderr, "Failed to find export '%s'\n", name);
+            exit(1);
+        }
+
+        return export_address;
+    }
+
+    bool create_fake_runtime(const std::string& directory)
+    {
+        auto assemblies = CreateTpaBase(false);
+        assemblies.push_back("Microsoft.Dnx.Host.CoreClr.dll");
+
+        for (auto assembly : assemblies)
+        {
+            std::ofstream file(dnx::utils::path_combine(directory, assembly).c_str(), std::ios::app);
+            if (!file)
+            {
+                fprintf(stderr, "Could not create %s in %s\n", assembly, directory.c_str());
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // The first CPU the calling thread is allowed to run on, -1 if not known
+    int get_first_cpu()
+    {
+        cpu_set_t cpus;
+        if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0)
+        {
+            return -1;
+        }
+
+        for (auto cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+            if (CPU_ISSET(cpu, &cpus))
+            {
+                return cpu;
+            }
+        }
+
+        return -1;
+    }
+
+    bool runs_only_on_cpu(int cpu)
+    {
+        cpu_set_t cpus;
+        return sched_getaffinity(0, sizeof(cpus), &cpus) == 0 && CPU_COUNT(&cpus) == 1 && CPU_ISSET(cpu, &cpus);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <runtime directory>\n", argv[0]);
+        return 1;
+    }
+
+    auto runtime_directory = argv[1];
+    if (!create_fake_runtime(runtime_directory))
+    {
+        return 1;
+    }
+
+    auto module_path = std::string(runtime_directory).append("/dnx.coreclr.so");
+    auto module = dlopen(module_path.c_str(), RTLD_NOW | RTLD_GLOBAL);
+    if (!module)
+    {
+        fprintf(stderr, "Failed to load '%s': %s\n", module_path.c_str(), dlerror());
+        return 1;
+    }
+
+    auto host_create = get_export<dnx_host_create_fn>(module, "dnx_host_create");
+    auto host_execute = get_export<dnx_host_execute_fn>(module, "dnx_host_execute");
+    auto host_destroy = get_export<dnx_host_destroy_fn>(module, "dnx_host_destroy");
+
+    char application_base[] = "/tmp/dnx.host.tests.XXXXXX";
+    if (!mkdtemp(application_base))
+    {
+        fprintf(stderr, "Failed to create the application base\n");
+        return 1;
+    }
+
+    auto config_path = std::string(application_base).append("/runtimeconfig.json");
+    std::ofstream(config_path.c_str()) << "{ \"configProperties\": { \"System.GC.Server\": ";
+
+    // not null so that the create has to reset it
+    auto host = reinterpret_cast<dnx_host*>(1);
+    check(host_create(runtime_directory, application_base, &host) != 0 && host == nullptr,
+        "create fails for a malformed runtimeconfig.json and resets the host");
+
+    unlink(config_path.c_str());
+
+    auto cpu = get_first_cpu();
+    setenv("DNX_CPUS", std::to_string(cpu).c_str(), 1);
+
+    check(host_create(runtime_directory, application_base, &host) == 0 && host != nullptr,
+        "create can be retried after failing before the runtime was initialized");
+
+    check(cpu < 0 || runs_only_on_cpu(cpu), "create places the calling thread on the CPUs of DNX_CPUS");
+
+    unsetenv("DNX_CPUS");
+
+    if (host)
+    {
+        setenv("DNX_FAKE_EXIT_CODE", "3", 1);
+        const char* app_argv[] = { "--appbase", application_base, "App" };
+        int exit_code = 0;
+        check(host_execute(host, 3, app_argv, &exit_code) == 0 && exit_code == 3,
+            "execute returns the exit code of the application");
+        unsetenv("DNX_FAKE_EXIT_CODE");
+
+        dnx_host* second_host;
+        check(host_create(runtime_directory, application_base, &second_host) != 0,
+            "create fails while a host exists");
+
+        check(host_destroy(host) == 0, "destroy shuts the runtime down");
+
+        check(host_create(runtime_directory, application_base, &second_host) != 0,
+            "create fails after the runtime has been shut down");
+    }
+
+    rmdir(application_base);
+
+    printf("%d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Threading;
+using Microsoft.Dnx.Runtime.Loader;
+using Microsoft.Extensions.PlatformAbstractions;
+
+namespace dnx.loader.benchmark
+{
+    /// <summary>
+    /// Loads the same graph of assembly names through a load context from a growing number of threads and
+    /// reports the throughput and the number of times the loader chain (LoadContext.LoadAssembly) ran. Most of the
+    /// names are never resolved, as with the probes that raise AssemblyResolve on the desktop CLR. The loader chain
+    /// runs again for the unresolved names once the misses are invalidated.
+    ///
+    /// usage: dnx run [unresolved names] [passes]
+    /// </summary>
+    public class Program
+    {
+        // The cost of a run of the loader chain, roughly the probes of the package, project and path loaders
+        private const int LoaderChainSpins = 2000;
+
+        public static int Main(string[] args)
+        {
+            var unresolvedCount = args.Length > 0 ? int.Parse(args[0]) : 400;
+            var passes = args.Length > 1 ? int.Parse(args[1]) : 200;
+
+            // Names the loader chain resolves have to be the names of real assemblies
+            var resolved = new[]
+            {
+                typeof(object),
+                typeof(Enumerable),
+                typeof(Console),
+                typeof(Stopwatch),
+                typeof(ConcurrentDictionary<,>),
+                typeof(LoadContext),
+                typeof(IAssemblyLoadContext),
+                typeof(Program)
+            }
+            .Select(type => type.GetTypeInfo().Assembly)
+            .GroupBy(assembly => assembly.GetName().Name)
+            .ToDictionary(group => group.Key, group => group.First(), StringComparer.Ordinal);
+
+            var names = resolved.Keys
+                .Select(name => new AssemblyName(name))
+                .Concat(Enumerable.Range(0, unresolvedCount).Select(i => new AssemblyName("Unresolved" + i)))
+                .ToArray();
+
+            Console.WriteLine("{0} names ({1} unresolved), {2} passes per thread", names.Length, unresolvedCount, passes);
+            Console.WriteLine("{0,8} {1,16} {2,14}", "threads", "loads/ms", "chain runs");
+
+            for (var threads = 1; threads <= Environment.ProcessorCount * 2; threads *= 2)
+            {
+                using (var loadContext = new BenchmarkLoadContext(resolved))
+                {
+                    Run(threads, names, passes, loadContext);
+                }
+            }
+
+            using (var loadContext = new BenchmarkLoadContext(resolved))
+            {
+                Run(1, names, 1, loadContext);
+
+                LoadContext.InvalidateLoadMisses();
+                var chainRuns = loadContext.ChainRuns;
+                Load(loadContext, names);
+                Console.WriteLine("chain runs after invalidating the misses: {0}", loadContext.ChainRuns - chainRuns);
+            }
+
+            return 0;
+        }
+
+        private static void Run(int threadCount, AssemblyName[] names, int passes, BenchmarkLoadContext loadContext)
+        {
+            using (var start = new Barrier(threadCount + 1))
+            {
+                var threads = Enumerable.Range(0, threadCount).Select(t => new Thread(() =>
+                {
+                    start.SignalAndWait();
+                    for (var pass = 0; pass < passes; pass++)
+                    {
+                        // Each thread walks the graph from a different name, as concurrent requests do
+                        Load(loadContext, names.Skip(t * 7 % names.Length).Concat(names.Take(t * 7 % names.Length)));
+                    }
+                })).ToList();
+
+                threads.ForEach(thread => thread.Start());
+                start.SignalAndWait();
+                var stopwatch = Stopwatch.StartNew();
+                threads.ForEach(thread => thread.Join());
+                stopwatch.Stop();
+
+                var loads = (double)threadCount * passes * names.Length;
+                Console.WriteLine("{0,8} {1,16:F0} {2,14}", threadCount,
+                    loads / Math.Max(stopwatch.Elapsed.TotalMilliseconds, 0.001), loadContext.ChainRuns);
+            }
+        }
+
+        private static void Load(IAssemblyLoadContext loadContext, IEnumerable<AssemblyName> names)
+        {
+            foreach (var name in names)
+            {
+                try
+                {
+                    loadContext.Load(name);
+                }
+                catch (FileNotFoundException)
+                {
+                    // The runtime reports a name no load context resolved by throwing
+                }
+            }
+        }
+
+        private class BenchmarkLoadContext : LoadContext
+        {
+            private readonly IDictionary<string, Assembly> _resolved;
+            private int _chainRuns;
+
+            public BenchmarkLoadContext(IDictionary<string, Assembly> resolved)
+                : base("dnx.loader.benchmark")
+            {
+                _resolved = resolved;
+            }
+
+            public int ChainRuns
+            {
+                get { return Volatile.Read(ref _chainRuns); }
+            }
+
+            public override Assembly LoadAssembly(AssemblyName assemblyName)
+            {
+                Interlocked.Increment(ref _chainRuns);
+                Thread.SpinWait(LoaderChainSpins);
+
+                Assembly assembly;
+                return _resolved.TryGetValue(assemblyName.Name, out assembly) ? assembly : null;
+            }
+        }
+    }
+}
@@ -0,0 +1,251 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+// Measures the native bootstrapper code that runs on every start with large synthetic inputs and reports the
+// time and the number of heap allocations per operation. Allocations are counted by replacing the global
+// operator new.
+//
+// usage: dnx.native.benchmark [iterations]
+
+#include "stdafx.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "pal.h"
+#include "tpa.h"
+#include "utils.h"
+
+bool ExpandCommandLineArguments(int argc, dnx::char_t** ppszArgv, dnx::utils::bootstrapper_options& options,
+    size_t& expanded_argc, dnx::char_t**& ppszExpandedArgv);
+void FreeExpandedCommandLineArguments(size_t argc, dnx::char_t** ppszArgv);
+
+// dnx.cpp depends on the platform layer which is not needed by the measured functions
+dnx::xstring_t GetNativeBootstrapperDirectory() { return dnx::xstring_t(); }
+bool IsTracingEnabled() { return false; }
+dnx::xstring_t GetTimingsFilePath() { return dnx::xstring_t(); }
+bool GetFullPath(const dnx::char_t* /*szPath*/, dnx::char_t* /*szFullPath*/) { return false; }
+int CallApplicationMain(const dnx::char_t* /*moduleName*/, const char* /*functionName*/, CALL_APPLICATION_MAIN_DATA* /*data*/, dnx::trace_writer& /*trace_writer*/) { return 0; }
+
+namespace
+{
+    std::atomic<long long> allocation_count{ 0 };
+}
+
+void* operator new(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    auto memory = malloc(size == 0 ? 1 : size);
+    if (!memory)
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
+namespace
+{
+    // Keeps the compiler from optimizing away the results of the measured functions
+    volatile size_t sink;
+
+    long long now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    template<typename Fn>
+    void measure(const char* name, int iterations, Fn fn)
+    {
+        // warm up the caches and the allocator
+        for (auto i = 0; i < std::max(1, iterations / 10); i++)
+        {
+            fn();
+        }
+
+        auto allocations = allocation_count.load();
+        auto start = now_ns();
+
+        for (auto i = 0; i < iterations; i++)
+        {
+            fn();
+        }
+
+        auto elapsed = now_ns() - start;
+        allocations = allocation_count.load() - allocations;
+
+        printf("%-48s %14.1f ns/op %10.2f allocs/op\n", name,
+            static_cast<double>(elapsed) / iterations, static_cast<double>(allocations) / iterations);
+    }
+
+    dnx::xstring_t create_deep_path(int depth)
+    {
+        dnx::xstring_t path;
+        for (auto i = 0; i < depth; i++)
+        {
+            path.append(_X("/directory")).append(std::to_string(i));
+        }
+
+        return path;
+    }
+
+    // Arguments are stored in a single vector so that the argv pointers stay valid
+    struct command_line
+    {
+        std::vector<dnx::xstring_t> storage;
+        std::vector<dnx::char_t*> argv;
+
+        void add(const dnx::xstring_t& argument)
+        {
+            storage.push_back(argument);
+        }
+
+        void finalize()
+        {
+            for (auto& argument : storage)
+            {
+                argv.push_back(&argument[0]);
+            }
+        }
+    };
+
+    // "dnx --lib <path> ... --lib <path> -p <path>/project.json run <arg> ... <arg>"
+    command_line create_command_line(int bootstrapper_options, int application_arguments, const dnx::xstring_t& path)
+    {
+        command_line command;
+        for (auto i = 0; i < bootstrapper_options; i++)
+        {
+            command.add(_X("--lib"));
+            command.add(path + _X("/lib") + std::to_string(i));
+        }
+
+        command.add(_X("-p"));
+        command.add(path + _X("/project.json"));
+        command.add(_X("run"));
+
+        for (auto i = 0; i < application_arguments; i++)
+        {
+            command.add(_X("--argument") + std::to_string(i));
+        }
+
+        command.finalize();
+        return command;
+    }
+
+    // Mirrors GetTrustedPlatformAssembliesList in dnx.coreclr.unix without probing for the files. The base list
+    // is repeated to simulate a runtime directory with many assemblies.
+    size_t build_trusted_platform_assemblies(const dnx::xstring_t& directory, int repeat)
+    {
+        auto tpas = CreateTpaBase(false);
+
+        dnx::xstring_t trusted_platform_assemblies;
+        for (auto i = 0; i < repeat; i++)
+        {
+            for (auto assembly_name : tpas)
+            {
+                trusted_platform_assemblies.append(dnx::utils::path_combine(directory, assembly_name));
+                trusted_platform_assemblies.append(_X(":"));
+            }
+        }
+
+        return trusted_platform_assemblies.length();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    auto iterations = argc > 1 ? atoi(argv[1]) : 10000;
+    if (iterations < 1)
+    {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    auto deep_path = create_deep_path(64);
+    auto long_command = create_command_line(1000, 1000, deep_path);
+    auto short_command = create_command_line(2, 2, deep_path);
+
+    printf("iterations: %d, path length: %zu, arguments: %zu\n\n", iterations, deep_path.length(), long_command.argv.size());
+
+    for (auto command : { &short_command, &long_command })
+    {
+        auto argument_count = static_cast<int>(command->argv.size());
+        auto arguments = command->argv.data();
+        auto suffix = command == &short_command ? " (short)" : " (long)";
+
+        measure((std::string("find_first_non_bootstrapper_param_index") + suffix).c_str(), iterations, [&]()
+        {
+            sink = static_cast<size_t>(dnx::utils::find_first_non_bootstrapper_param_index(argument_count, arguments));
+        });
+
+        measure((std::string("parse_bootstrapper_options") + suffix).c_str(), iterations, [&]()
+        {
+            sink = static_cast<size_t>(dnx::utils::parse_bootstrapper_options(argument_count, arguments).first_non_bootstrapper_param_index);
+        });
+
+        auto parsed_options = dnx::utils::parse_bootstrapper_options(argument_count, arguments);
+        measure((std::string("ExpandCommandLineArguments") + suffix).c_str(), iterations, [&]()
+        {
+            auto options = parsed_options;
+            size_t expanded_argc = 0;
+            dnx::char_t** expanded_argv = nullptr;
+            if (ExpandCommandLineArguments(argument_count, arguments, options, expanded_argc, expanded_argv))
+            {
+                sink = expanded_argc;
+                FreeExpandedCommandLineArguments(expanded_argc, expanded_argv);
+            }
+        });
+    }
+
+    auto file_path = deep_path + _X("/Microsoft.Dnx.Host.CoreClr.dll");
+
+    measure("path_combine", iterations, [&]()
+    {
+        sink = dnx::utils::path_combine(deep_path, _X("Microsoft.Dnx.Host.CoreClr.dll")).length();
+    });
+
+    measure("remove_file_from_path", iterations, [&]()
+    {
+        sink = dnx::utils::remove_file_from_path(file_path).length();
+    });
+
+    measure("CreateTpaBase", iterations, [&]()
+    {
+        sink = CreateTpaBase(false).size();
+    });
+
+    auto tpa_iterations = std::max(1, iterations / 100);
+
+    measure("trusted platform assemblies (x1)", tpa_iterations, [&]()
+    {
+        sink = build_trusted_platform_assemblies(deep_path, 1);
+    });
+
+    measure("trusted platform assemblies (x20)", tpa_iterations, [&]()
+    {
+        sink = build_trusted_platform_assemblies(deep_path, 20);
+    });
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+// Measures the cold start time of an application with and without the prefetching of the startup files
+// (see prefetch.h). Before each run the startup files are evicted from the page cache, the runs with
+// DNX_PREFETCH=0 and DNX_PREFETCH=1 are interleaved so that both see the same disk conditions.
+//
+// Pages are evicted with posix_fadvise(POSIX_FADV_DONTNEED) which does not require root but only drops clean
+// pages that are not mapped by another process. Run 'sync; echo 3 > /proc/sys/vm/drop_caches' for a
+// completely cold cache.
+//
+// usage: dnx.prefetch.benchmark <runtime directory> <application base> <iterations> <command...>
+// e.g. dnx.prefetch.benchmark ~/.dnx/runtimes/dnx-coreclr-linux-x64.1.0.0/bin /src/app 10 dnx -p /src/app run
+
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "prefetch.h"
+
+namespace
+{
+    long long now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    size_t evict(const std::vector<std::string>& files)
+    {
+        size_t evicted = 0;
+        for (auto& file : files)
+        {
+            auto fd = open(file.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                continue;
+            }
+
+            fdatasync(fd);
+            if (posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0)
+            {
+                evicted++;
+            }
+
+            close(fd);
+        }
+
+        return evicted;
+    }
+
+    // Runs the command with DNX_PREFETCH set to the given value and returns the wall time in nanoseconds
+    long long run(char** command, const char* prefetch)
+    {
+        auto start = now_ns();
+
+        auto pid = fork();
+        if (pid < 0)
+        {
+            perror("fork");
+            exit(1);
+        }
+
+        if (pid == 0)
+        {
+            setenv("DNX_PREFETCH", prefetch, 1);
+            execvp(command[0], command);
+            perror(command[0]);
+            _exit(127);
+        }
+
+        int status;
+        if (waitpid(pid, &status, 0) < 0)
+        {
+            perror("waitpid");
+            exit(1);
+        }
+
+        auto elapsed = now_ns() - start;
+
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            fprintf(stderr, "The command failed with status %d\n", status);
+        }
+
+        return elapsed;
+    }
+
+    void report(const char* name, std::vector<long long> samples)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        long long total = 0;
+        for (auto ns : samples)
+        {
+            total += ns;
+        }
+
+        printf("%s\n", name);
+        printf("  mean:       %12.3f ms\n", total / 1e6 / samples.size());
+        printf("  min:        %12.3f ms\n", samples.front() / 1e6);
+        printf("  median:     %12.3f ms\n", samples[samples.size() / 2] / 1e6);
+        printf("  max:        %12.3f ms\n", samples.back() / 1e6);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 5)
+    {
+        fprintf(stderr, "usage: %s <runtime directory> <application base> <iterations> <command...>\n", argv[0]);
+        return 1;
+    }
+
+    std::string runtime_directory = argv[1];
+    std::string application_base = argv[2];
+    auto iterations = atoi(argv[3]);
+    auto command = &argv[4];
+
+    if (iterations < 1)
+    {
+        fprintf(stderr, "The number of iterations must be greater than 0\n");
+        return 1;
+    }
+
+    auto files = dnx::prefetch::get_startup_files(runtime_directory, application_base);
+    files.push_back(runtime_directory + "/dnx.coreclr.so");
+    files.push_back(runtime_directory + "/dnx");
+
+    auto evicted = evict(files);
+    printf("startup files: %zu (%zu found)\n", files.size(), evicted);
+
+    std::vector<long long> without_prefetch;
+    std::vector<long long> with_prefetch;
+    for (auto i = 0; i < iterations; i++)
+    {
+        evict(files);
+        without_prefetch.push_back(run(command, "0"));
+
+        evict(files);
+        with_prefetch.push_back(run(command, "1"));
+    }
+
+    report("DNX_PREFETCH=0", without_prefetch);
+    report("DNX_PREFETCH=1", with_prefetch);
+
+    return 0;
+}
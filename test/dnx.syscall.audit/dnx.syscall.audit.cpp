@@ -0,0 +1,370 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+// Runs a command under the syscall_audit.so interposer and reports the opens, stats, reads, mmaps and other file
+// system calls (readlink, realpath, uname) of each bootstrapper phase. The calls of the main thread are attributed
+// to the innermost phase written to DNX_TRACE_TIMINGS that was running at the time, the calls of the other threads
+// (e.g. the prefetch thread) are reported together.
+//
+// With --budget the counts are compared to the budget file and the exit code is 1 if any of them is exceeded. Each
+// line of the budget file is "<row> <opens> <stats> <reads> <mmaps> <other>" where '-' skips a column and '#' starts
+// a comment. With --fake-runtime the trusted platform assemblies are created as empty files in the given directory
+// so that the host can be audited with fake_coreclr.cpp instead of libcoreclr.
+//
+// usage: dnx.syscall.audit [--budget <file>] [--fake-runtime <dir>] [--warmup <n>] [--events] <syscall_audit.so> <command...>
+// e.g. dnx.syscall.audit --budget budget.txt ./syscall_audit.so ~/.dnx/runtimes/dnx-coreclr-linux-x64.1.0.0/bin/dnx --version
+
+#include <algorithm>
+#include <fstream>
+#include <limits.h>
+#include <map>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "tpa.h"
+#include "utils.h"
+
+namespace
+{
+    const char* KINDS[] = { "open", "stat", "read", "mmap", "other" };
+    const size_t KIND_COUNT = sizeof(KINDS) / sizeof(KINDS[0]);
+
+    const char* BETWEEN_PHASES = "[between-phases]";
+    const char* OTHER_THREADS = "[other-threads]";
+    const char* TOTAL = "[total]";
+
+    struct phase
+    {
+        std::string name;
+        long long start_ns;
+        long long end_ns;
+    };
+
+    struct event
+    {
+        long long time_ns;
+        long pid;
+        long tid;
+        std::string kind;
+        std::string detail;
+    };
+
+    struct counts
+    {
+        long long values[KIND_COUNT] = {};
+    };
+
+    std::string create_temp_file(const char* name)
+    {
+        char path[] = "/tmp/dnx.syscall.audit.XXXXXX";
+        auto fd = mkstemp(path);
+        if (fd < 0)
+        {
+            perror("mkstemp");
+            exit(1);
+        }
+
+        close(fd);
+        return std::string(path).append(".").append(name);
+    }
+
+    int run(char** command, const std::string& shim, const std::string& log_path, const std::string& timings_path)
+    {
+        auto pid = fork();
+        if (pid < 0)
+        {
+            perror("fork");
+            exit(1);
+        }
+
+        if (pid == 0)
+        {
+            setenv("LD_PRELOAD", shim.c_str(), 1);
+            setenv("DNX_SYSCALL_AUDIT_LOG", log_path.c_str(), 1);
+            setenv("DNX_TRACE_TIMINGS", timings_path.c_str(), 1);
+            execvp(command[0], command);
+            perror(command[0]);
+            _exit(127);
+        }
+
+        int status;
+        if (waitpid(pid, &status, 0) < 0)
+        {
+            perror("waitpid");
+            exit(1);
+        }
+
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            fprintf(stderr, "The command failed with status %d\n", status);
+        }
+
+        return pid;
+    }
+
+    // {"pid":1234,"phase":"dlopen","start_us":5678,"duration_us":90}
+    std::vector<phase> read_phases(const std::string& path, long pid)
+    {
+        std::vector<phase> phases;
+        std::ifstream file(path.c_str());
+        for (std::string line; std::getline(file, line); )
+        {
+            long phase_pid;
+            char name[256];
+            long long start_us, duration_us;
+            if (sscanf(line.c_str(), "{\"pid\":%ld,\"phase\":\"%255[^\"]\",\"start_us\":%lld,\"duration_us\":%lld}",
+                &phase_pid, name, &start_us, &duration_us) == 4 && phase_pid == pid)
+            {
+                // the timer truncates to microseconds - the end is rounded up so that no call of the phase is lost
+                phases.push_back(phase{ name, start_us * 1000, (start_us + duration_us + 1) * 1000 });
+            }
+        }
+
+        return phases;
+    }
+
+    std::vector<event> read_events(const std::string& path, long pid)
+    {
+        std::vector<event> events;
+        std::ifstream file(path.c_str());
+        for (std::string line; std::getline(file, line); )
+        {
+            std::istringstream fields(line);
+            event e;
+            if (fields >> e.time_ns >> e.pid >> e.tid >> e.kind && e.pid == pid)
+            {
+                std::getline(fields >> std::ws, e.detail);
+                events.push_back(e);
+            }
+        }
+
+        return events;
+    }
+
+    std::string find_row(const event& e, const std::vector<phase>& phases)
+    {
+        if (e.tid != e.pid)
+        {
+            return OTHER_THREADS;
+        }
+
+        const phase* innermost = nullptr;
+        for (auto& p : phases)
+        {
+            if (e.time_ns >= p.start_ns && e.time_ns <= p.end_ns &&
+                (!innermost || p.end_ns - p.start_ns < innermost->end_ns - innermost->start_ns))
+            {
+                innermost = &p;
+            }
+        }
+
+        return innermost ? innermost->name : BETWEEN_PHASES;
+    }
+
+    size_t kind_index(const std::string& kind)
+    {
+        for (size_t i = 0; i < KIND_COUNT; i++)
+        {
+            if (kind == KINDS[i])
+            {
+                return i;
+            }
+        }
+
+        return KIND_COUNT - 1;
+    }
+
+    // Returns the number of counts over the budget
+    int check_budget(const std::string& path, const std::map<std::string, counts>& rows)
+    {
+        std::ifstream file(path.c_str());
+        if (!file)
+        {
+            fprintf(stderr, "Could not open the budget file %s\n", path.c_str());
+            return 1;
+        }
+
+        auto failures = 0;
+        for (std::string line; std::getline(file, line); )
+        {
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream fields(line);
+            std::string row;
+            if (!(fields >> row))
+            {
+                continue;
+            }
+
+            auto actual = rows.find(row);
+            for (size_t i = 0; i < KIND_COUNT; i++)
+            {
+                std::string limit;
+                if (!(fields >> limit))
+                {
+                    fprintf(stderr, "Malformed budget line: %s\n", line.c_str());
+                    return failures + 1;
+                }
+
+                if (limit == "-")
+                {
+                    continue;
+                }
+
+                auto value = actual == rows.end() ? 0 : actual->second.values[i];
+                if (value > atoll(limit.c_str()))
+                {
+                    fprintf(stderr, "Over budget: %s %s %lld (budget %s)\n", row.c_str(), KINDS[i], value, limit.c_str());
+                    failures++;
+                }
+            }
+        }
+
+        return failures;
+    }
+
+    bool create_fake_runtime(const std::string& directory)
+    {
+        auto assemblies = CreateTpaBase(false);
+        assemblies.push_back("Microsoft.Dnx.Host.CoreClr.dll");
+
+        for (auto assembly : assemblies)
+        {
+            std::ofstream file(dnx::utils::path_combine(directory, assembly).c_str(), std::ios::app);
+            if (!file)
+            {
+                fprintf(stderr, "Could not create %s in %s\n", assembly, directory.c_str());
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string budget_path, fake_runtime;
+    auto warmup = 1;
+    auto print_events = false;
+
+    auto i = 1;
+    for (; i < argc && strncmp(argv[i], "--", 2) == 0; i++)
+    {
+        if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc)
+        {
+            budget_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--fake-runtime") == 0 && i + 1 < argc)
+        {
+            fake_runtime = argv[++i];
+        }
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+        {
+            warmup = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--events") == 0)
+        {
+            print_events = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (argc - i < 2)
+    {
+        fprintf(stderr, "usage: %s [--budget <file>] [--fake-runtime <dir>] [--warmup <n>] [--events] <syscall_audit.so> <command...>\n", argv[0]);
+        return 1;
+    }
+
+    char shim[PATH_MAX];
+    if (!realpath(argv[i], shim))
+    {
+        fprintf(stderr, "Could not find %s\n", argv[i]);
+        return 1;
+    }
+
+    auto command = &argv[i + 1];
+
+    if (!fake_runtime.empty() && !create_fake_runtime(fake_runtime))
+    {
+        return 1;
+    }
+
+    auto log_path = create_temp_file("log");
+    auto timings_path = create_temp_file("timings");
+
+    // The first runs persist the caches of the host (e.g. the TPA manifest) - only the last run is reported
+    long pid = 0;
+    for (auto run_index = 0; run_index <= warmup; run_index++)
+    {
+        unlink(log_path.c_str());
+        unlink(timings_path.c_str());
+        pid = run(command, shim, log_path, timings_path);
+    }
+
+    auto phases = read_phases(timings_path, pid);
+    auto events = read_events(log_path, pid);
+
+    unlink(log_path.c_str());
+    unlink(timings_path.c_str());
+
+    if (phases.empty())
+    {
+        fprintf(stderr, "No phases were recorded - is the command a dnx host?\n");
+        return 1;
+    }
+
+    std::vector<std::string> row_names;
+    for (auto& p : phases)
+    {
+        if (std::find(row_names.begin(), row_names.end(), p.name) == row_names.end())
+        {
+            row_names.push_back(p.name);
+        }
+    }
+
+    row_names.push_back(BETWEEN_PHASES);
+    row_names.push_back(OTHER_THREADS);
+    row_names.push_back(TOTAL);
+
+    std::map<std::string, counts> rows;
+    for (auto& e : events)
+    {
+        auto row = find_row(e, phases);
+        auto kind = kind_index(e.kind);
+        rows[row].values[kind]++;
+        rows[TOTAL].values[kind]++;
+
+        if (print_events)
+        {
+            printf("%-28s %-6s %s\n", row.c_str(), e.kind.c_str(), e.detail.c_str());
+        }
+    }
+
+    printf("%-28s", "phase");
+    for (auto kind : KINDS)
+    {
+        printf(" %8s", kind);
+    }
+    printf("\n");
+
+    for (auto& name : row_names)
+    {
+        printf("%-28s", name.c_str());
+        for (auto value : rows[name].values)
+        {
+            printf(" %8lld", value);
+        }
+        printf("\n");
+    }
+
+    return budget_path.empty() || check_budget(budget_path, rows) == 0 ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+// Stands in for libcoreclr so that the system calls of the native host can be audited without a runtime. The
+// managed entry point returns immediately with the exit code in DNX_FAKE_EXIT_CODE (0 by default).
+
+#include <stdlib.h>
+
+namespace
+{
+    int host_main(const int /*argc*/, const wchar_t** /*argv*/, const void* /*context*/)
+    {
+        auto exit_code = getenv("DNX_FAKE_EXIT_CODE");
+        return exit_code ? atoi(exit_code) : 0;
+    }
+
+    int host_handle;
+}
+
+extern "C"
+{
+    int coreclr_initialize(const char* /*exePath*/, const char* /*appDomainFriendlyName*/, int /*propertyCount*/,
+        const char** /*propertyKeys*/, const char** /*propertyValues*/, void** hostHandle, unsigned int* domainId)
+    {
+        *hostHandle = &host_handle;
+        *domainId = 1;
+        return 0;
+    }
+
+    int coreclr_create_delegate(void* /*hostHandle*/, unsigned int /*domainId*/, const char* /*entryPointAssemblyName*/,
+        const char* /*entryPointTypeName*/, const char* /*entryPointMethodName*/, void** delegate)
+    {
+        *delegate = reinterpret_cast<void*>(&host_main);
+        return 0;
+    }
+
+    int coreclr_shutdown(void* /*hostHandle*/, unsigned int /*domainId*/)
+    {
+        return 0;
+    }
+}
@@ -0,0 +1,337 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+// LD_PRELOAD interposer that logs the file system calls of a process to the file named by DNX_SYSCALL_AUDIT_LOG.
+// Each line is "<monotonic time ns> <pid> <tid> <kind> <detail>" where kind is one of open, stat, read, mmap
+// and other. The time uses the clock of dnx::phase_timer so that dnx.syscall.audit can attribute the calls to the
+// bootstrapper phases written to DNX_TRACE_TIMINGS.
+//
+// Only calls made through the dynamic symbol table are seen - calls made by libc to itself (e.g. the lstat calls of
+// realpath) and by the dynamic loader (the opens and mmaps of dlopen) are not. Calls on the timings file are ignored.
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace
+{
+    int log_fd = -2;
+    const char* timings_file = nullptr;
+
+    void initialize()
+    {
+        auto log_path = getenv("DNX_SYSCALL_AUDIT_LOG");
+        timings_file = getenv("DNX_TRACE_TIMINGS");
+
+        // the raw system calls do not go through the interposed functions
+        log_fd = log_path
+            ? static_cast<int>(syscall(SYS_openat, AT_FDCWD, log_path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644))
+            : -1;
+    }
+
+    __attribute__((constructor)) void initialize_on_load()
+    {
+        if (log_fd == -2)
+        {
+            initialize();
+        }
+    }
+
+    void record(const char* kind, const char* detail)
+    {
+        if (log_fd == -2)
+        {
+            initialize();
+        }
+
+        if (log_fd < 0 || (detail && timings_file && strcmp(detail, timings_file) == 0))
+        {
+            return;
+        }
+
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        char line[PATH_MAX + 128];
+        auto length = snprintf(line, sizeof(line), "%lld %ld %ld %s %s\n",
+            static_cast<long long>(now.tv_sec) * 1000000000LL + now.tv_nsec, static_cast<long>(getpid()),
+            static_cast<long>(syscall(SYS_gettid)), kind, detail && *detail ? detail : "-");
+
+        if (length > 0)
+        {
+            syscall(SYS_write, log_fd, line, static_cast<size_t>(length < static_cast<int>(sizeof(line)) ? length : sizeof(line) - 1));
+        }
+    }
+
+    void record_fd(const char* kind, int fd)
+    {
+        char detail[32];
+        snprintf(detail, sizeof(detail), "fd:%d", fd);
+        record(kind, detail);
+    }
+
+    template<typename T>
+    T next(const char* name)
+    {
+        return reinterpret_cast<T>(dlsym(RTLD_NEXT, name));
+    }
+
+    mode_t get_mode(int flags, va_list& args)
+    {
+        return (flags & (O_CREAT | O_TMPFILE)) ? static_cast<mode_t>(va_arg(args, int)) : 0;
+    }
+}
+
+extern "C"
+{
+    // Not declared by recent versions of glibc but still called by binaries built against older versions
+    int __xstat(int version, const char* path, struct stat* buffer);
+    int __lxstat(int version, const char* path, struct stat* buffer);
+    int __fxstat(int version, int fd, struct stat* buffer);
+    int __fxstatat(int version, int dirfd, const char* path, struct stat* buffer, int flags);
+
+    int open(const char* path, int flags, ...)
+    {
+        va_list args;
+        va_start(args, flags);
+        auto mode = get_mode(flags, args);
+        va_end(args);
+
+        record("open", path);
+        static auto real = next<int(*)(const char*, int, ...)>("open");
+        return real(path, flags, mode);
+    }
+
+    int open64(const char* path, int flags, ...)
+    {
+        va_list args;
+        va_start(args, flags);
+        auto mode = get_mode(flags, args);
+        va_end(args);
+
+        record("open", path);
+        static auto real = next<int(*)(const char*, int, ...)>("open64");
+        return real(path, flags, mode);
+    }
+
+    int openat(int dirfd, const char* path, int flags, ...)
+    {
+        va_list args;
+        va_start(args, flags);
+        auto mode = get_mode(flags, args);
+        va_end(args);
+
+        record("open", path);
+        static auto real = next<int(*)(int, const char*, int, ...)>("openat");
+        return real(dirfd, path, flags, mode);
+    }
+
+    int openat64(int dirfd, const char* path, int flags, ...)
+    {
+        va_list args;
+        va_start(args, flags);
+        auto mode = get_mode(flags, args);
+        va_end(args);
+
+        record("open", path);
+        static auto real = next<int(*)(int, const char*, int, ...)>("openat64");
+        return real(dirfd, path, flags, mode);
+    }
+
+    FILE* fopen(const char* path, const char* mode)
+    {
+        record("open", path);
+        static auto real = next<FILE*(*)(const char*, const char*)>("fopen");
+        return real(path, mode);
+    }
+
+    FILE* fopen64(const char* path, const char* mode)
+    {
+        record("open", path);
+        static auto real = next<FILE*(*)(const char*, const char*)>("fopen64");
+        return real(path, mode);
+    }
+
+    DIR* opendir(const char* path)
+    {
+        record("open", path);
+        static auto real = next<DIR*(*)(const char*)>("opendir");
+        return real(path);
+    }
+
+    int stat(const char* path, struct stat* buffer)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(const char*, struct stat*)>("stat");
+        return real(path, buffer);
+    }
+
+    int lstat(const char* path, struct stat* buffer)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(const char*, struct stat*)>("lstat");
+        return real(path, buffer);
+    }
+
+    int fstat(int fd, struct stat* buffer)
+    {
+        record_fd("stat", fd);
+        static auto real = next<int(*)(int, struct stat*)>("fstat");
+        return real(fd, buffer);
+    }
+
+    int fstatat(int dirfd, const char* path, struct stat* buffer, int flags)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(int, const char*, struct stat*, int)>("fstatat");
+        return real(dirfd, path, buffer, flags);
+    }
+
+    int stat64(const char* path, struct stat64* buffer)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(const char*, struct stat64*)>("stat64");
+        return real(path, buffer);
+    }
+
+    int lstat64(const char* path, struct stat64* buffer)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(const char*, struct stat64*)>("lstat64");
+        return real(path, buffer);
+    }
+
+    int fstat64(int fd, struct stat64* buffer)
+    {
+        record_fd("stat", fd);
+        static auto real = next<int(*)(int, struct stat64*)>("fstat64");
+        return real(fd, buffer);
+    }
+
+    int __xstat(int version, const char* path, struct stat* buffer)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(int, const char*, struct stat*)>("__xstat");
+        return real(version, path, buffer);
+    }
+
+    int __lxstat(int version, const char* path, struct stat* buffer)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(int, const char*, struct stat*)>("__lxstat");
+        return real(version, path, buffer);
+    }
+
+    int __fxstat(int version, int fd, struct stat* buffer)
+    {
+        record_fd("stat", fd);
+        static auto real = next<int(*)(int, int, struct stat*)>("__fxstat");
+        return real(version, fd, buffer);
+    }
+
+    int __fxstatat(int version, int dirfd, const char* path, struct stat* buffer, int flags)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(int, int, const char*, struct stat*, int)>("__fxstatat");
+        return real(version, dirfd, path, buffer, flags);
+    }
+
+#if defined(STATX_BASIC_STATS)
+    int statx(int dirfd, const char* path, int flags, unsigned int mask, struct statx* buffer)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(int, const char*, int, unsigned int, struct statx*)>("statx");
+        return real(dirfd, path, flags, mask, buffer);
+    }
+#endif
+
+    int access(const char* path, int mode)
+    {
+        record("stat", path);
+        static auto real = next<int(*)(const char*, int)>("access");
+        return real(path, mode);
+    }
+
+    ssize_t read(int fd, void* buffer, size_t count)
+    {
+        record_fd("read", fd);
+        static auto real = next<ssize_t(*)(int, void*, size_t)>("read");
+        return real(fd, buffer, count);
+    }
+
+    ssize_t pread(int fd, void* buffer, size_t count, off_t offset)
+    {
+        record_fd("read", fd);
+        static auto real = next<ssize_t(*)(int, void*, size_t, off_t)>("pread");
+        return real(fd, buffer, count, offset);
+    }
+
+    ssize_t pread64(int fd, void* buffer, size_t count, off64_t offset)
+    {
+        record_fd("read", fd);
+        static auto real = next<ssize_t(*)(int, void*, size_t, off64_t)>("pread64");
+        return real(fd, buffer, count, offset);
+    }
+
+    ssize_t readv(int fd, const struct iovec* vectors, int count)
+    {
+        record_fd("read", fd);
+        static auto real = next<ssize_t(*)(int, const struct iovec*, int)>("readv");
+        return real(fd, vectors, count);
+    }
+
+    void* mmap(void* address, size_t length, int protection, int flags, int fd, off_t offset)
+    {
+        if (fd >= 0)
+        {
+            record_fd("mmap", fd);
+        }
+
+        static auto real = next<void*(*)(void*, size_t, int, int, int, off_t)>("mmap");
+        return real(address, length, protection, flags, fd, offset);
+    }
+
+    void* mmap64(void* address, size_t length, int protection, int flags, int fd, off64_t offset)
+    {
+        if (fd >= 0)
+        {
+            record_fd("mmap", fd);
+        }
+
+        static auto real = next<void*(*)(void*, size_t, int, int, int, off64_t)>("mmap64");
+        return real(address, length, protection, flags, fd, offset);
+    }
+
+    ssize_t readlink(const char* path, char* buffer, size_t size)
+    {
+        record("other", path);
+        static auto real = next<ssize_t(*)(const char*, char*, size_t)>("readlink");
+        return real(path, buffer, size);
+    }
+
+    char* realpath(const char* path, char* resolved_path)
+    {
+        record("other", path);
+        static auto real = next<char*(*)(const char*, char*)>("realpath");
+        return real(path, resolved_path);
+    }
+
+    int uname(struct utsname* name)
+    {
+        record("other", "uname");
+        static auto real = next<int(*)(struct utsname*)>("uname");
+        return real(name);
+    }
+}
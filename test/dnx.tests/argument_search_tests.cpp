@@ -54,4 +54,97 @@ TEST(parameter_search, find_bootstrapper_option_index_returns_param_index_if_par
 {
     dnx::char_t* args[]{ _X("--port"), _X("1234"), _X("--appbase"), _X("C:\\temp") };
     ASSERT_EQ(2, dnx::utils::find_bootstrapper_option_index(4, args, _X("--appbase")));
-}
\ No newline at end of file
+}
+
+TEST(parameter_search, parse_bootstrapper_options_returns_defaults_if_no_params)
+{
+    auto options = dnx::utils::parse_bootstrapper_options(0, nullptr);
+    ASSERT_EQ(-1, options.first_non_bootstrapper_param_index);
+    ASSERT_EQ(-1, options.appbase_index);
+    ASSERT_EQ(-1, options.project_index);
+    ASSERT_EQ(nullptr, options.appbase);
+    ASSERT_FALSE(options.bootstrapper_debug);
+    ASSERT_FALSE(options.perf_map);
+    ASSERT_EQ(nullptr, options.cpus);
+    ASSERT_EQ(nullptr, options.numa_node);
+    ASSERT_EQ(nullptr, options.packages);
+}
+
+TEST(parameter_search, parse_bootstrapper_options_finds_options_before_first_non_bootstrapper_param)
+{
+    dnx::char_t* args[]{ _X("--BOOTSTRAPPER-DEBUG"), _X("-P"), _X("MyApp"), _X("--appbase"), _X("C:\\temp"), _X("run"), _X("--appbase"), _X("C:\\other") };
+    auto options = dnx::utils::parse_bootstrapper_options(8, args);
+    ASSERT_EQ(5, options.first_non_bootstrapper_param_index);
+    ASSERT_EQ(3, options.appbase_index);
+    ASSERT_EQ(1, options.project_index);
+    ASSERT_STREQ(_X("C:\\temp"), options.appbase);
+    ASSERT_TRUE(options.bootstrapper_debug);
+}
+
+TEST(parameter_search, parse_bootstrapper_options_finds_perf_map)
+{
+    dnx::char_t* args[]{ _X("--perf-map"), _X("--appbase"), _X("C:\\temp"), _X("run"), _X("--perf-map") };
+    auto options = dnx::utils::parse_bootstrapper_options(5, args);
+    ASSERT_EQ(3, options.first_non_bootstrapper_param_index);
+    ASSERT_EQ(1, options.appbase_index);
+    ASSERT_TRUE(options.perf_map);
+    ASSERT_FALSE(options.bootstrapper_debug);
+}
+
+TEST(parameter_search, parse_bootstrapper_options_skips_load_summary)
+{
+    dnx::char_t* args[]{ _X("--load-summary"), _X("--appbase"), _X("C:\\temp"), _X("run") };
+    auto options = dnx::utils::parse_bootstrapper_options(4, args);
+    ASSERT_EQ(3, options.first_non_bootstrapper_param_index);
+    ASSERT_EQ(1, options.appbase_index);
+}
+
+TEST(parameter_search, parse_bootstrapper_options_finds_placement)
+{
+    dnx::char_t* args[]{ _X("--cpus"), _X("0-3,8"), _X("--NUMA-NODE"), _X("1"), _X("run"), _X("--cpus"), _X("4") };
+    auto options = dnx::utils::parse_bootstrapper_options(7, args);
+    ASSERT_EQ(4, options.first_non_bootstrapper_param_index);
+    ASSERT_STREQ(_X("0-3,8"), options.cpus);
+    ASSERT_STREQ(_X("1"), options.numa_node);
+}
+
+TEST(parameter_search, parse_bootstrapper_options_finds_packages)
+{
+    dnx::char_t* args[]{ _X("--packages"), _X("/packages"), _X("--appbase"), _X("C:\\temp"), _X("run"), _X("--packages"), _X("/other") };
+    auto options = dnx::utils::parse_bootstrapper_options(7, args);
+    ASSERT_EQ(4, options.first_non_bootstrapper_param_index);
+    ASSERT_EQ(2, options.appbase_index);
+    ASSERT_STREQ(_X("/packages"), options.packages);
+}
+
+TEST(parameter_search, parse_bootstrapper_options_returns_null_placement_if_value_missing)
+{
+    dnx::char_t* args[]{ _X("--numa-node") };
+    auto options = dnx::utils::parse_bootstrapper_options(1, args);
+    ASSERT_EQ(-1, options.first_non_bootstrapper_param_index);
+    ASSERT_EQ(nullptr, options.numa_node);
+}
+
+TEST(parameter_search, parse_bootstrapper_options_does_not_treat_option_values_as_options)
+{
+    dnx::char_t* args[]{ _X("--lib"), _X("--appbase"), _X("run") };
+    auto options = dnx::utils::parse_bootstrapper_options(3, args);
+    ASSERT_EQ(2, options.first_non_bootstrapper_param_index);
+    ASSERT_EQ(-1, options.appbase_index);
+}
+
+TEST(parameter_search, parse_bootstrapper_options_returns_null_appbase_if_value_missing)
+{
+    dnx::char_t* args[]{ _X("--port"), _X("1234"), _X("--appbase") };
+    auto options = dnx::utils::parse_bootstrapper_options(3, args);
+    ASSERT_EQ(-1, options.first_non_bootstrapper_param_index);
+    ASSERT_EQ(2, options.appbase_index);
+    ASSERT_EQ(nullptr, options.appbase);
+}
+
+TEST(parameter_search, parse_bootstrapper_options_does_not_match_option_prefixes)
+{
+    dnx::char_t* args[]{ _X("--appbase-x"), _X("--app"), _X("-") };
+    auto options = dnx::utils::parse_bootstrapper_options(3, args);
+    ASSERT_EQ(0, options.first_non_bootstrapper_param_index);
+}
@@ -0,0 +1,171 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "container_limits.h"
+#include <fstream>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <vector>
+
+namespace
+{
+    // A fake /proc/self/mountinfo, /proc/self/cgroup and the cgroup file systems they point to
+    class cgroup_fixture
+    {
+    public:
+        cgroup_fixture()
+        {
+            char path_template[] = "/tmp/dnx.tests.XXXXXX";
+            m_root = mkdtemp(path_template);
+        }
+
+        ~cgroup_fixture()
+        {
+            for (auto it = m_paths.rbegin(); it != m_paths.rend(); ++it)
+            {
+                remove(it->c_str());
+            }
+
+            rmdir(m_root.c_str());
+        }
+
+        std::string path(const std::string& relative_path) const
+        {
+            return std::string(m_root).append("/").append(relative_path);
+        }
+
+        // Creates the file and the directories leading to it
+        void write_file(const std::string& relative_path, const std::string& content)
+        {
+            for (auto slash = relative_path.find('/'); slash != std::string::npos; slash = relative_path.find('/', slash + 1))
+            {
+                auto directory = path(relative_path.substr(0, slash));
+                if (mkdir(directory.c_str(), 0700) == 0)
+                {
+                    m_paths.push_back(directory);
+                }
+            }
+
+            std::ofstream(path(relative_path).c_str()) << content;
+            m_paths.push_back(path(relative_path));
+        }
+
+        dnx::container_limits get_limits() const
+        {
+            return dnx::get_container_limits(path("mountinfo").c_str(), path("cgroup").c_str());
+        }
+
+    private:
+        std::string m_root;
+        std::vector<std::string> m_paths;
+    };
+
+    const uint64_t MB = 1024 * 1024;
+
+    // Quotas of at least the online processors are no limit
+    unsigned int expected_cpu_count(unsigned int cpu_count)
+    {
+        return cpu_count < static_cast<unsigned int>(sysconf(_SC_NPROCESSORS_ONLN)) ? cpu_count : 0;
+    }
+
+    void write_cgroup_v1(cgroup_fixture& fixture, const std::string& mount_root, const std::string& cgroup_path)
+    {
+        fixture.write_file("mountinfo",
+            "25 1 8:1 / / rw,relatime - ext4 /dev/sda1 rw\n"
+            "30 25 0:26 " + mount_root + " " + fixture.path("sys/cpu,cpuacct") + " rw,nosuid shared:9 - cgroup cgroup rw,cpu,cpuacct\n"
+            "31 25 0:27 " + mount_root + " " + fixture.path("sys/memory") + " rw,nosuid shared:10 - cgroup cgroup rw,memory\n");
+        fixture.write_file("cgroup",
+            "12:pids:" + cgroup_path + "\n"
+            "4:cpu,cpuacct:" + cgroup_path + "\n"
+            "3:memory:" + cgroup_path + "\n"
+            "0::/\n");
+    }
+
+    void write_cgroup_v2(cgroup_fixture& fixture, const std::string& cgroup_path)
+    {
+        fixture.write_file("mountinfo",
+            "25 1 8:1 / / rw,relatime - ext4 /dev/sda1 rw\n"
+            "35 25 0:30 / " + fixture.path("sys/unified") + " rw,nosuid,nodev,noexec shared:4 - cgroup2 cgroup2 rw,nsdelegate\n");
+        fixture.write_file("cgroup", "0::" + cgroup_path + "\n");
+    }
+}
+
+TEST(container_limits, reads_cgroup_v1_limits)
+{
+    cgroup_fixture fixture;
+    write_cgroup_v1(fixture, "/", "/docker/app");
+    fixture.write_file("sys/cpu,cpuacct/docker/app/cpu.cfs_quota_us", "150000\n");
+    fixture.write_file("sys/cpu,cpuacct/docker/app/cpu.cfs_period_us", "100000\n");
+    fixture.write_file("sys/memory/docker/app/memory.limit_in_bytes", std::to_string(256 * MB) + "\n");
+
+    auto limits = fixture.get_limits();
+    ASSERT_EQ(expected_cpu_count(2), limits.cpu_count);
+    ASSERT_EQ(256 * MB, limits.memory_limit);
+}
+
+TEST(container_limits, reads_cgroup_v1_limits_of_container_mounted_at_its_cgroup)
+{
+    // inside the container the root of the mounts is the cgroup of the container
+    cgroup_fixture fixture;
+    write_cgroup_v1(fixture, "/docker/app", "/docker/app");
+    fixture.write_file("sys/cpu,cpuacct/cpu.cfs_quota_us", "100000\n");
+    fixture.write_file("sys/cpu,cpuacct/cpu.cfs_period_us", "100000\n");
+    fixture.write_file("sys/memory/memory.limit_in_bytes", std::to_string(512 * MB) + "\n");
+
+    auto limits = fixture.get_limits();
+    ASSERT_EQ(expected_cpu_count(1), limits.cpu_count);
+    ASSERT_EQ(512 * MB, limits.memory_limit);
+}
+
+TEST(container_limits, reports_no_cgroup_v1_limits_if_unlimited)
+{
+    cgroup_fixture fixture;
+    write_cgroup_v1(fixture, "/", "/user.slice");
+    fixture.write_file("sys/cpu,cpuacct/user.slice/cpu.cfs_quota_us", "-1\n");
+    fixture.write_file("sys/cpu,cpuacct/user.slice/cpu.cfs_period_us", "100000\n");
+    fixture.write_file("sys/memory/user.slice/memory.limit_in_bytes", "9223372036854771712\n");
+
+    auto limits = fixture.get_limits();
+    ASSERT_EQ(0u, limits.cpu_count);
+    ASSERT_EQ(0u, limits.memory_limit);
+}
+
+TEST(container_limits, reads_cgroup_v2_limits)
+{
+    cgroup_fixture fixture;
+    write_cgroup_v2(fixture, "/system.slice/app.service");
+    fixture.write_file("sys/unified/system.slice/app.service/cpu.max", "250000 100000\n");
+    fixture.write_file("sys/unified/system.slice/app.service/memory.max", std::to_string(128 * MB) + "\n");
+
+    auto limits = fixture.get_limits();
+    ASSERT_EQ(expected_cpu_count(3), limits.cpu_count);
+    ASSERT_EQ(128 * MB, limits.memory_limit);
+}
+
+TEST(container_limits, reports_no_cgroup_v2_limits_if_unlimited)
+{
+    cgroup_fixture fixture;
+    write_cgroup_v2(fixture, "/");
+    fixture.write_file("sys/unified/cpu.max", "max 100000\n");
+    fixture.write_file("sys/unified/memory.max", "max\n");
+
+    auto limits = fixture.get_limits();
+    ASSERT_EQ(0u, limits.cpu_count);
+    ASSERT_EQ(0u, limits.memory_limit);
+}
+
+TEST(container_limits, reports_no_limits_without_cgroup_mounts)
+{
+    cgroup_fixture fixture;
+    fixture.write_file("mountinfo", "25 1 8:1 / / rw,relatime - ext4 /dev/sda1 rw\n");
+    fixture.write_file("cgroup", "0::/\n");
+
+    auto limits = fixture.get_limits();
+    ASSERT_EQ(0u, limits.cpu_count);
+    ASSERT_EQ(0u, limits.memory_limit);
+
+    limits = dnx::get_container_limits(fixture.path("missing").c_str(), fixture.path("missing").c_str());
+    ASSERT_EQ(0u, limits.cpu_count);
+    ASSERT_EQ(0u, limits.memory_limit);
+}
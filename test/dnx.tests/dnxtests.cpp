@@ -3,9 +3,17 @@
 
 #include "stdafx.h"
 
+#if defined(_WIN32)
 int _tmain(int argc, _TCHAR* argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
     RUN_ALL_TESTS();
     return 0;
-}
\ No newline at end of file
+}
+#else
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,83 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "json_scanner.h"
+#include <cstring>
+
+using dnx::json::scanner;
+using dnx::json::token_type;
+
+scanner create_scanner(const char* json)
+{
+    return scanner(json, strlen(json));
+}
+
+TEST(json_scanner, next_returns_tokens_in_document_order)
+{
+    auto s = create_scanner("{ \"a\": [1, -2.5e3, true, false, null], \"b\": {} }");
+
+    ASSERT_EQ(token_type::begin_object, s.next());
+    ASSERT_EQ(token_type::string, s.next());
+    ASSERT_TRUE(s.string_equals("a"));
+    ASSERT_EQ(token_type::begin_array, s.next());
+    ASSERT_EQ(token_type::number, s.next());
+    ASSERT_EQ("1", s.token_value());
+    ASSERT_EQ(token_type::number, s.next());
+    ASSERT_EQ("-2.5e3", s.token_value());
+    ASSERT_EQ(token_type::true_value, s.next());
+    ASSERT_EQ(token_type::false_value, s.next());
+    ASSERT_EQ(token_type::null_value, s.next());
+    ASSERT_EQ(token_type::end_array, s.next());
+    ASSERT_EQ(token_type::string, s.next());
+    ASSERT_EQ(token_type::begin_object, s.next());
+    ASSERT_EQ(token_type::end_object, s.next());
+    ASSERT_EQ(token_type::end_object, s.next());
+    ASSERT_EQ(token_type::end, s.next());
+}
+
+TEST(json_scanner, string_tokens_decode_escape_sequences)
+{
+    auto s = create_scanner("\"a\\\"b\\\\c\\u00e9\\ud83d\\ude00\"");
+
+    ASSERT_EQ(token_type::string, s.next());
+    ASSERT_EQ("a\"b\\c\xc3\xa9\xf0\x9f\x98\x80", s.token_value());
+    ASSERT_TRUE(s.string_equals("a\"b\\c\xc3\xa9\xf0\x9f\x98\x80"));
+    ASSERT_FALSE(s.string_equals("a\"b\\c"));
+}
+
+TEST(json_scanner, comments_and_bom_are_skipped)
+{
+    auto s = create_scanner("\xEF\xBB\xBF// comment\n{ /* comment */ }");
+
+    ASSERT_EQ(token_type::begin_object, s.next());
+    ASSERT_EQ(token_type::end_object, s.next());
+    ASSERT_EQ(token_type::end, s.next());
+}
+
+TEST(json_scanner, skip_value_skips_nested_values)
+{
+    auto s = create_scanner("{ \"skipped\": { \"a\": [ { \"b\": 1 } ] }, \"next\": 2 }");
+
+    ASSERT_EQ(token_type::begin_object, s.next());
+    ASSERT_EQ(token_type::string, s.next());
+    ASSERT_EQ(token_type::begin_object, s.next());
+    ASSERT_TRUE(s.skip_value());
+    ASSERT_EQ(token_type::string, s.next());
+    ASSERT_TRUE(s.string_equals("next"));
+}
+
+TEST(json_scanner, malformed_tokens_are_reported_as_errors)
+{
+    ASSERT_EQ(token_type::error, create_scanner("\"unterminated").next());
+    ASSERT_EQ(token_type::error, create_scanner("\"\\x\"").next());
+    ASSERT_EQ(token_type::error, create_scanner("tru").next());
+    ASSERT_EQ(token_type::error, create_scanner("-").next());
+    ASSERT_EQ(token_type::error, create_scanner("/* unterminated").next());
+
+    auto s = create_scanner("{ \"a\": [ 1, 2");
+    ASSERT_EQ(token_type::begin_object, s.next());
+    ASSERT_EQ(token_type::string, s.next());
+    ASSERT_EQ(token_type::begin_array, s.next());
+    ASSERT_FALSE(s.skip_value());
+}
@@ -0,0 +1,129 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "packages_directory.h"
+#include <fstream>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <vector>
+
+namespace
+{
+    // A solution directory with the application in src/app
+    class solution_directory
+    {
+    public:
+        solution_directory()
+        {
+            char path_template[] = "/tmp/dnx.tests.XXXXXX";
+            m_root = mkdtemp(path_template);
+            mkdir(path("src").c_str(), 0700);
+            mkdir(path("src/app").c_str(), 0700);
+        }
+
+        ~solution_directory()
+        {
+            unlink(path("global.json").c_str());
+            rmdir(path("src/app").c_str());
+            rmdir(path("src").c_str());
+            rmdir(m_root.c_str());
+        }
+
+        std::string path(const std::string& relative_path) const
+        {
+            return std::string(m_root).append("/").append(relative_path);
+        }
+
+        void write_global_json(const std::string& content)
+        {
+            std::ofstream(path("global.json").c_str()) << content;
+        }
+
+    private:
+        std::string m_root;
+    };
+
+    // Sets the variables the packages directory is resolved from for the lifetime of the instance
+    class environment
+    {
+    public:
+        environment(const char* nuget_packages, const char* dnx_packages, const char* home)
+        {
+            set("NUGET_PACKAGES", nuget_packages);
+            set("DNX_PACKAGES", dnx_packages);
+            set("HOME", home);
+        }
+
+        ~environment()
+        {
+            for (auto& variable : m_saved)
+            {
+                if (variable.second.first)
+                {
+                    setenv(variable.first.c_str(), variable.second.second.c_str(), 1);
+                }
+                else
+                {
+                    unsetenv(variable.first.c_str());
+                }
+            }
+        }
+
+    private:
+        void set(const char* name, const char* value)
+        {
+            auto saved = getenv(name);
+            m_saved.push_back({ name, { saved != nullptr, saved ? saved : "" } });
+
+            if (value)
+            {
+                setenv(name, value, 1);
+            }
+            else
+            {
+                unsetenv(name);
+            }
+        }
+
+        std::vector<std::pair<std::string, std::pair<bool, std::string>>> m_saved;
+    };
+}
+
+TEST(packages_directory, get_packages_directory_reads_global_json_of_solution)
+{
+    environment environment("/nuget", "/dnx", "/home/user");
+    solution_directory solution;
+
+    solution.write_global_json("{ \"projects\": [ \"src\" ], \"packages\": \"packages\" }");
+    ASSERT_EQ(solution.path("packages"), dnx::get_packages_directory(solution.path("src/app")));
+
+    solution.write_global_json("{ \"sdk\": { \"version\": \"1.0.0\" }, \"packages\": \"/opt/packages\" }");
+    ASSERT_EQ("/opt/packages", dnx::get_packages_directory(solution.path("src/app")));
+}
+
+TEST(packages_directory, get_packages_directory_falls_back_to_environment)
+{
+    solution_directory solution;
+    solution.write_global_json("{ \"projects\": [ \"src\" ] }");
+
+    {
+        environment environment("/nuget", "/dnx", "/home/user");
+        ASSERT_EQ("/nuget", dnx::get_packages_directory(solution.path("src/app")));
+    }
+
+    {
+        environment environment("", "/dnx", "/home/user");
+        ASSERT_EQ("/dnx", dnx::get_packages_directory(solution.path("src/app")));
+    }
+
+    {
+        environment environment(nullptr, nullptr, "/home/user");
+        ASSERT_EQ("/home/user/.nuget/packages", dnx::get_packages_directory(solution.path("src/app")));
+    }
+
+    {
+        environment environment(nullptr, nullptr, nullptr);
+        ASSERT_EQ("", dnx::get_packages_directory(solution.path("src/app")));
+    }
+}
@@ -8,7 +8,8 @@
 #include "trace_writer.h"
 #include "app_main.h"
 
-dnx::xstring_t GetNativeBootstrapperDirectory() { return L""; }
+dnx::xstring_t GetNativeBootstrapperDirectory() { return _X(""); }
 bool IsTracingEnabled() { return true; }
-bool GetFullPath(const wchar_t* /*szPath*/, wchar_t* /*szFullPath*/) { return false; }
-int CallApplicationMain(const wchar_t* /*moduleName*/, const char* /*functionName*/, CALL_APPLICATION_MAIN_DATA* /*data*/, dnx::trace_writer& /*trace_writer*/) { return 3; }
\ No newline at end of file
+dnx::xstring_t GetTimingsFilePath() { return _X(""); }
+bool GetFullPath(const dnx::char_t* /*szPath*/, dnx::char_t* /*szFullPath*/) { return false; }
+int CallApplicationMain(const dnx::char_t* /*moduleName*/, const char* /*functionName*/, CALL_APPLICATION_MAIN_DATA* /*data*/, dnx::trace_writer& /*trace_writer*/) { return 3; }
\ No newline at end of file
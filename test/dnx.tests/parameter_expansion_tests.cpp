@@ -3,10 +3,12 @@
 
 #include "stdafx.h"
 #include "xplat.h"
+#include "utils.h"
 #include <vector>
 #include <unordered_map>
 
 bool ExpandCommandLineArguments(int nArgc, dnx::char_t** ppszArgv, size_t& nExpandedArgc, dnx::char_t**& ppszExpandedArgv);
+bool ExpandCommandLineArguments(int nArgc, dnx::char_t** ppszArgv, dnx::utils::bootstrapper_options& options, size_t& nExpandedArgc, dnx::char_t**& ppszExpandedArgv);
 void FreeExpandedCommandLineArguments(size_t nArgc, dnx::char_t** ppszArgv);
 
 template <size_t arg_count>
@@ -261,4 +263,18 @@ TEST(parameter_expansion, ExpandCommandLineArguments_should_not_expand_if_both_p
     dnx::char_t** expanded_args = nullptr;
     ASSERT_FALSE(ExpandCommandLineArguments(6, args, expanded_arg_count, expanded_args));
     ASSERT_EQ(nullptr, expanded_args);
-}
\ No newline at end of file
+}
+
+TEST(parameter_expansion, ExpandCommandLineArguments_should_update_appbase_option_to_implicit_appbase)
+{
+    dnx::char_t* args[]{ _X("--port"), _X("1234"), _X("-p"), _X("C:\\MyApp\\project.json"), _X("cmd") };
+    auto options = dnx::utils::parse_bootstrapper_options(5, args);
+    size_t expanded_arg_count;
+    dnx::char_t** expanded_args = nullptr;
+
+    ASSERT_TRUE(ExpandCommandLineArguments(5, args, options, expanded_arg_count, expanded_args));
+    ASSERT_STREQ(_X("C:\\MyApp\\"), options.appbase);
+    ASSERT_EQ(expanded_args[3], options.appbase);
+
+    FreeExpandedCommandLineArguments(expanded_arg_count, expanded_args);
+}
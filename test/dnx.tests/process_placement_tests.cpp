@@ -0,0 +1,75 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "process_placement.h"
+
+TEST(process_placement, parse_cpu_list_parses_cpus_and_ranges)
+{
+    std::vector<int> cpus;
+    ASSERT_TRUE(dnx::parse_cpu_list("3", cpus));
+    ASSERT_EQ(std::vector<int>({ 3 }), cpus);
+
+    ASSERT_TRUE(dnx::parse_cpu_list("0-3,8,10-11", cpus));
+    ASSERT_EQ(std::vector<int>({ 0, 1, 2, 3, 8, 10, 11 }), cpus);
+
+    ASSERT_TRUE(dnx::parse_cpu_list("5-5", cpus));
+    ASSERT_EQ(std::vector<int>({ 5 }), cpus);
+}
+
+TEST(process_placement, parse_cpu_list_sorts_and_removes_duplicates)
+{
+    std::vector<int> cpus;
+    ASSERT_TRUE(dnx::parse_cpu_list("8,2-4,3,0", cpus));
+    ASSERT_EQ(std::vector<int>({ 0, 2, 3, 4, 8 }), cpus);
+}
+
+TEST(process_placement, parse_cpu_list_fails_for_invalid_lists)
+{
+    std::vector<int> cpus { 1 };
+    ASSERT_FALSE(dnx::parse_cpu_list("", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list(",", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list("1,,2", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list("-1", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list("1-", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list("3-1", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list("1-2-3", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list("a", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list(" 1", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list("0-1000000", cpus));
+    ASSERT_FALSE(dnx::parse_cpu_list("1024", cpus));
+
+    // the CPUs are not changed if the list is invalid
+    ASSERT_EQ(std::vector<int>({ 1 }), cpus);
+}
+
+TEST(process_placement, format_cpu_list_writes_consecutive_cpus_as_ranges)
+{
+    ASSERT_EQ("", dnx::format_cpu_list({ }));
+    ASSERT_EQ("4", dnx::format_cpu_list({ 4 }));
+    ASSERT_EQ("0-1", dnx::format_cpu_list({ 0, 1 }));
+    ASSERT_EQ("0-3,8,10-11", dnx::format_cpu_list({ 0, 1, 2, 3, 8, 10, 11 }));
+}
+
+TEST(process_placement, format_cpu_list_is_inverse_of_parse_cpu_list)
+{
+    std::vector<int> cpus;
+    ASSERT_TRUE(dnx::parse_cpu_list("11,0-2,7,5-6", cpus));
+    ASSERT_EQ("0-2,5-7,11", dnx::format_cpu_list(cpus));
+}
+
+TEST(process_placement, resolve_process_placement_validates_values)
+{
+    dnx::process_placement placement;
+    std::string error;
+    ASSERT_TRUE(dnx::resolve_process_placement("1,0", nullptr, placement, error));
+    ASSERT_EQ(std::vector<int>({ 0, 1 }), placement.cpus);
+    ASSERT_EQ(-1, placement.numa_node);
+
+    ASSERT_FALSE(dnx::resolve_process_placement("x", nullptr, placement, error));
+    ASSERT_FALSE(error.empty());
+
+    error.clear();
+    ASSERT_FALSE(dnx::resolve_process_placement(nullptr, "node0", placement, error));
+    ASSERT_FALSE(error.empty());
+}
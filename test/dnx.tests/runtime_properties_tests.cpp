@@ -0,0 +1,110 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "runtime_properties.h"
+#include <fstream>
+#include <stdlib.h>
+
+namespace
+{
+    class config_file
+    {
+    public:
+        explicit config_file(const char* content)
+        {
+            char path_template[] = "/tmp/dnx.tests.XXXXXX";
+            close(mkstemp(path_template));
+            m_path = path_template;
+
+            std::ofstream(m_path.c_str(), std::ios::trunc) << content;
+        }
+
+        ~config_file()
+        {
+            unlink(m_path.c_str());
+        }
+
+        const std::string& path() const
+        {
+            return m_path;
+        }
+
+    private:
+        std::string m_path;
+    };
+
+    bool load_config(const char* content, dnx::runtime_properties& properties, std::string& error)
+    {
+        config_file file(content);
+        return properties.load_config_file(file.path(), error);
+    }
+
+    typedef std::vector<std::pair<std::string, std::string>> property_list;
+}
+
+TEST(runtime_properties, load_config_file_loads_config_properties)
+{
+    dnx::runtime_properties properties;
+    std::string error;
+    ASSERT_TRUE(load_config(
+        "{ \"runtimeOptions\": { \"gcServer\": [ 1 ] }, "
+        "\"configProperties\": { \"System.GC.Server\": true, \"System.GC.Concurrent\": false, \"Count\": 1, \"Name\": \"value\" } }",
+        properties, error));
+
+    ASSERT_EQ(property_list({
+        { "System.GC.Server", "true" },
+        { "System.GC.Concurrent", "false" },
+        { "Count", "1" },
+        { "Name", "value" } }), properties.items());
+    ASSERT_EQ("", error);
+}
+
+TEST(runtime_properties, load_config_file_succeeds_if_file_does_not_exist)
+{
+    dnx::runtime_properties properties;
+    std::string error;
+    ASSERT_TRUE(properties.load_config_file("/tmp/dnx.tests.missing/runtimeconfig.json", error));
+    ASSERT_TRUE(properties.items().empty());
+    ASSERT_EQ("", error);
+}
+
+TEST(runtime_properties, load_config_file_fails_for_malformed_file)
+{
+    const char* malformed_files[] =
+    {
+        "",
+        "[ ]",
+        "{ \"configProperties\": { \"System.GC.Server\": true ",
+        "{ \"configProperties\": [ \"System.GC.Server\" ] }",
+        "{ \"configProperties\": { \"System.GC.Server\": { \"value\": true } } }",
+        "{ \"configProperties\": { 1: true } }",
+        "{ \"runtimeOptions\": { , \"configProperties\": {} }"
+    };
+
+    for (auto content : malformed_files)
+    {
+        dnx::runtime_properties properties;
+        std::string error;
+        ASSERT_FALSE(load_config(content, properties, error)) << content;
+        ASSERT_NE("", error) << content;
+    }
+}
+
+TEST(runtime_properties, apply_environment_overrides_config_properties)
+{
+    dnx::runtime_properties properties;
+    properties.set("System.GC.Server", "false");
+    properties.set("Name", "value");
+
+    setenv("DNX_GC_SERVER", "1", 1);
+    setenv("DNX_RUNTIME_PROPERTIES", "Name=other;=ignored;malformed;;Key=a=b", 1);
+    properties.apply_environment();
+    unsetenv("DNX_GC_SERVER");
+    unsetenv("DNX_RUNTIME_PROPERTIES");
+
+    ASSERT_EQ(property_list({
+        { "System.GC.Server", "true" },
+        { "Name", "other" },
+        { "Key", "a=b" } }), properties.items());
+}
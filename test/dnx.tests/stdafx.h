@@ -3,10 +3,19 @@
 
 #pragma once
 
+#if defined(_WIN32)
 #include <tchar.h>
 #include <strsafe.h>
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#else
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_PATH PATH_MAX
+#endif
 
 #include "gtest/gtest.h"
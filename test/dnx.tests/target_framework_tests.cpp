@@ -0,0 +1,39 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "target_framework.h"
+#include <cstring>
+
+bool select_target_framework(const char* project_json, std::string& framework)
+{
+    return dnx::select_target_framework(project_json, strlen(project_json), framework);
+}
+
+TEST(target_framework, selects_first_coreclr_framework)
+{
+    std::string framework;
+    ASSERT_TRUE(select_target_framework(
+        "{ \"version\": \"1.0.0-*\", \"frameworks\": { \"dnx451\": { \"frameworkAssemblies\": { \"System.Xml\": \"\" } }, "
+        "\"netstandardapp1.5\": { \"imports\": [ \"dnxcore50\" ] }, \"dnxcore50\": {} } }", framework));
+    ASSERT_EQ("netstandardapp1.5", framework);
+}
+
+TEST(target_framework, returns_empty_framework_if_no_coreclr_framework)
+{
+    std::string framework;
+    ASSERT_TRUE(select_target_framework("{ \"frameworks\": { \"dnx451\": {}, \"net46\": {} } }", framework));
+    ASSERT_EQ("", framework);
+
+    ASSERT_TRUE(select_target_framework("// comment\n{ \"dependencies\": { \"frameworks\": { \"dnxcore50\": {} } } }", framework));
+    ASSERT_EQ("", framework);
+}
+
+TEST(target_framework, fails_for_malformed_documents)
+{
+    std::string framework;
+    ASSERT_FALSE(select_target_framework("", framework));
+    ASSERT_FALSE(select_target_framework("[ \"dnxcore50\" ]", framework));
+    ASSERT_FALSE(select_target_framework("{ \"frameworks\": { \"dnx451\": { ", framework));
+    ASSERT_FALSE(select_target_framework("{ \"frameworks\": { \"dnx451\": \"\\x\" } }", framework));
+}
@@ -0,0 +1,121 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "tpa_manifest.h"
+#include <fcntl.h>
+#include <fstream>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+namespace
+{
+    class runtime_directory
+    {
+    public:
+        runtime_directory()
+        {
+            char path_template[] = "/tmp/dnx.tests.XXXXXX";
+            m_path = mkdtemp(path_template);
+        }
+
+        ~runtime_directory()
+        {
+            unlink(manifest_path().c_str());
+            unlink(file_path("System.Runtime.dll").c_str());
+            rmdir(m_path.c_str());
+        }
+
+        const std::string& path() const
+        {
+            return m_path;
+        }
+
+        std::string manifest_path() const
+        {
+            return file_path("dnx.coreclr.tpa");
+        }
+
+        std::string file_path(const char* file_name) const
+        {
+            return std::string(m_path).append("/").append(file_name);
+        }
+
+        // The modification time is set explicitly since the clock of the file system can be too coarse for two
+        // changes made in a row to get different times
+        void set_modification_time(time_t seconds)
+        {
+            struct timespec times[2] = { { seconds, 0 }, { seconds, 0 } };
+            utimensat(AT_FDCWD, m_path.c_str(), times, 0);
+        }
+
+    private:
+        std::string m_path;
+    };
+
+    const char* TPA = "/runtime/System.Runtime.dll:/runtime/mscorlib.ni.dll";
+}
+
+TEST(tpa_manifest, load_returns_saved_list)
+{
+    runtime_directory directory;
+    ASSERT_TRUE(dnx::tpa_manifest::save(directory.path(), TPA));
+
+    dnx::tpa_manifest manifest;
+    ASSERT_TRUE(manifest.load(directory.path()));
+    ASSERT_STREQ(TPA, manifest.trusted_platform_assemblies());
+
+    // the temporary file the manifest was written to has been renamed
+    auto temp_path = directory.manifest_path().append(".").append(std::to_string(getpid()));
+    ASSERT_NE(0, access(temp_path.c_str(), F_OK));
+}
+
+TEST(tpa_manifest, load_fails_if_manifest_does_not_exist)
+{
+    runtime_directory directory;
+
+    dnx::tpa_manifest manifest;
+    ASSERT_FALSE(manifest.load(directory.path()));
+    ASSERT_EQ(nullptr, manifest.trusted_platform_assemblies());
+    ASSERT_FALSE(manifest.load(directory.file_path("missing")));
+}
+
+TEST(tpa_manifest, load_fails_if_runtime_directory_changed)
+{
+    runtime_directory directory;
+    directory.set_modification_time(1000000000);
+    ASSERT_TRUE(dnx::tpa_manifest::save(directory.path(), TPA));
+
+    dnx::tpa_manifest manifest;
+    ASSERT_TRUE(manifest.load(directory.path()));
+
+    // an assembly added to the runtime directory
+    std::ofstream(directory.file_path("System.Runtime.dll")).put('\0');
+    directory.set_modification_time(1000000001);
+
+    ASSERT_FALSE(manifest.load(directory.path()));
+    ASSERT_EQ(nullptr, manifest.trusted_platform_assemblies());
+
+    // saving again stamps the manifest with the new modification time
+    ASSERT_TRUE(dnx::tpa_manifest::save(directory.path(), TPA));
+    ASSERT_TRUE(manifest.load(directory.path()));
+    ASSERT_STREQ(TPA, manifest.trusted_platform_assemblies());
+}
+
+TEST(tpa_manifest, load_fails_for_malformed_manifest)
+{
+    runtime_directory directory;
+    ASSERT_TRUE(dnx::tpa_manifest::save(directory.path(), TPA));
+
+    // truncated - the length in the header does not match the size of the file
+    struct stat manifest_stat;
+    ASSERT_EQ(0, stat(directory.manifest_path().c_str(), &manifest_stat));
+    ASSERT_EQ(0, truncate(directory.manifest_path().c_str(), manifest_stat.st_size - 2));
+
+    dnx::tpa_manifest manifest;
+    ASSERT_FALSE(manifest.load(directory.path()));
+
+    // not a manifest
+    std::ofstream(directory.manifest_path(), std::ios::trunc) << "System.Runtime.dll:mscorlib.dll";
+    ASSERT_FALSE(manifest.load(directory.path()));
+}
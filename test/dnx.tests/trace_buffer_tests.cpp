@@ -0,0 +1,112 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "trace_buffer.h"
+#include <sstream>
+#include <stdlib.h>
+#include <vector>
+
+namespace
+{
+    // The lines of the dump without the timestamps and the thread ids
+    std::vector<std::string> dump(const dnx::trace_buffer& buffer)
+    {
+        char path_template[] = "/tmp/dnx.tests.XXXXXX";
+        auto fd = mkstemp(path_template);
+        unlink(path_template);
+
+        buffer.dump(fd);
+
+        std::string text;
+        char chunk[4096];
+        lseek(fd, 0, SEEK_SET);
+        for (ssize_t count; (count = read(fd, chunk, sizeof(chunk))) > 0; )
+        {
+            text.append(chunk, static_cast<size_t>(count));
+        }
+
+        close(fd);
+
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        for (std::string line; std::getline(stream, line); )
+        {
+            if (lines.empty())
+            {
+                lines.push_back(line);
+                continue;
+            }
+
+            // <timestamp> <source> <thread id> <level> <message>
+            std::istringstream fields(line);
+            std::string timestamp, source, thread_id, level;
+            fields >> timestamp >> source >> thread_id >> level;
+            lines.push_back(source + " " + level + " " + line.substr(static_cast<size_t>(fields.tellg()) + 1));
+        }
+
+        return lines;
+    }
+
+    void write(dnx::trace_buffer& buffer, const std::string& message)
+    {
+        buffer.write(dnx::trace_buffer::source::native, 3, message.c_str(), message.length());
+    }
+}
+
+TEST(trace_buffer, dump_writes_events_oldest_first)
+{
+    dnx::trace_buffer buffer(4);
+    write(buffer, "first");
+    buffer.write(dnx::trace_buffer::source::managed, 1, u"second", 6);
+
+    ASSERT_EQ(std::vector<std::string>({
+        "dnx trace buffer: 2 of 2 events",
+        "native 3 first",
+        "managed 1 second" }), dump(buffer));
+}
+
+TEST(trace_buffer, dump_writes_header_only_if_buffer_is_empty)
+{
+    dnx::trace_buffer buffer(4);
+    ASSERT_EQ(std::vector<std::string>({ "dnx trace buffer: 0 of 0 events" }), dump(buffer));
+}
+
+TEST(trace_buffer, oldest_events_are_overwritten_when_buffer_wraps_around)
+{
+    // rounded up to 4 events
+    dnx::trace_buffer buffer(3);
+    for (auto i = 0; i < 10; i++)
+    {
+        write(buffer, "event " + std::to_string(i));
+    }
+
+    ASSERT_EQ(std::vector<std::string>({
+        "dnx trace buffer: 4 of 10 events",
+        "native 3 event 6",
+        "native 3 event 7",
+        "native 3 event 8",
+        "native 3 event 9" }), dump(buffer));
+}
+
+TEST(trace_buffer, long_messages_are_truncated)
+{
+    dnx::trace_buffer buffer(1);
+    write(buffer, std::string(dnx::trace_buffer::message_capacity, 'a') + "bcd");
+
+    auto lines = dump(buffer);
+    ASSERT_EQ(2u, lines.size());
+    ASSERT_EQ("native 3 " + std::string(dnx::trace_buffer::message_capacity, 'a'), lines[1]);
+}
+
+TEST(trace_buffer, managed_messages_are_written_as_utf8_on_a_single_line)
+{
+    dnx::trace_buffer buffer(2);
+    buffer.write(dnx::trace_buffer::source::managed, 2, u"aé€\U0001F600\nb", 7);
+    buffer.write(dnx::trace_buffer::source::managed, 2, u"\xD800x", 2);
+
+    ASSERT_EQ(std::vector<std::string>({
+        "dnx trace buffer: 2 of 2 events",
+        "managed 2 a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 b",
+        "managed 2 ?x" }), dump(buffer));
+}
@@ -0,0 +1,78 @@
+// Copyright (c) .NET Foundation. All rights reserved.
+// Licensed under the Apache License, Version 2.0. See License.txt in the project root for license information.
+
+#include "stdafx.h"
+#include "utf8.h"
+#include "arena.h"
+#include "xplat.h"
+#include <cstring>
+#include <stdint.h>
+#include <string>
+
+std::u16string to_utf16(const char* source)
+{
+    auto length = strlen(source);
+    std::u16string result(length, u'\0');
+    result.resize(dnx::utf8::to_utf16(source, length, &result[0]));
+    return result;
+}
+
+TEST(utf8, to_utf16_converts_empty_string)
+{
+    ASSERT_EQ(std::u16string(), to_utf16(""));
+}
+
+TEST(utf8, to_utf16_converts_ascii_strings)
+{
+    ASSERT_EQ(std::u16string(u"abc"), to_utf16("abc"));
+    ASSERT_EQ(std::u16string(u"/usr/local/lib/dnx/runtimes/dnx-coreclr-linux-x64/bin"),
+        to_utf16("/usr/local/lib/dnx/runtimes/dnx-coreclr-linux-x64/bin"));
+}
+
+TEST(utf8, to_utf16_converts_multibyte_sequences)
+{
+    ASSERT_EQ(std::u16string(u"\u00e9"), to_utf16("\xc3\xa9"));
+    ASSERT_EQ(std::u16string(u"\u20ac"), to_utf16("\xe2\x82\xac"));
+    ASSERT_EQ(std::u16string(u"\U0001F600"), to_utf16("\xf0\x9f\x98\x80"));
+}
+
+TEST(utf8, to_utf16_converts_multibyte_sequences_crossing_blocks)
+{
+    ASSERT_EQ(std::u16string(u"/home/user/projects/caf\u00e9/\U0001F600/project.json"),
+        to_utf16("/home/user/projects/caf\xc3\xa9/\xf0\x9f\x98\x80/project.json"));
+}
+
+TEST(utf8, to_utf16_replaces_invalid_sequences)
+{
+    // stray continuation byte, overlong encoding, encoded surrogate, truncated sequence
+    ASSERT_EQ(std::u16string(u"a\uFFFDb"), to_utf16("a\x80" "b"));
+    ASSERT_EQ(std::u16string(u"\uFFFD\uFFFD"), to_utf16("\xc0\xaf"));
+    ASSERT_EQ(std::u16string(u"\uFFFD\uFFFD\uFFFD"), to_utf16("\xed\xa0\x80"));
+    ASSERT_EQ(std::u16string(u"abc\uFFFD\uFFFD"), to_utf16("abc\xe2\x82"));
+}
+
+TEST(arena, allocations_are_aligned_and_do_not_overlap)
+{
+    dnx::arena arena{ dnx::arena::required_size<char>(3) + dnx::arena::required_size<void*>(2) };
+
+    auto chars = arena.allocate<char>(3);
+    auto pointers = arena.allocate<void*>(2);
+
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(pointers) % alignof(void*));
+    ASSERT_TRUE(reinterpret_cast<char*>(pointers) >= chars + 3);
+}
+
+TEST(arena, copy_adds_null_terminator)
+{
+    dnx::arena arena{ dnx::arena::required_size<dnx::char_t>(4) };
+
+    ASSERT_STREQ(_X("abc"), arena.copy(_X("abcdef"), 3));
+}
+
+TEST(arena, allocate_throws_if_arena_exhausted)
+{
+    dnx::arena arena{ 8 };
+
+    arena.allocate<char>(8);
+    ASSERT_THROW(arena.allocate<char>(1), std::bad_alloc);
+}